@@ -8,4 +8,17 @@ meta:
 common:
 	# dependencies with other addons, a list of them separated by spaces 
 	# or use += in several lines
-	ADDON_DEPENDENCIES = ofxJSON ofxLibwebsockets
\ No newline at end of file
+	ADDON_DEPENDENCIES = ofxJSON ofxLibwebsockets ofxNetwork
+
+linux64:
+	# shm_open() for SharedMemoryPublisher & Reader on older glibc
+	ADDON_LDFLAGS = -lrt
+
+linux:
+	ADDON_LDFLAGS = -lrt
+
+linuxarmv6l:
+	ADDON_LDFLAGS = -lrt
+
+linuxarmv7l:
+	ADDON_LDFLAGS = -lrt
@@ -0,0 +1,334 @@
+#include "ofApp.h"
+
+// A typical orientation message as sent by Myo Connect
+static const string orientationMessage =
+	"[\"event\",{\"type\":\"orientation\",\"timestamp\":\"1419549413446735\",\"myo\":0,"
+	"\"orientation\":{\"x\":-0.4627685546875,\"y\":-0.14501953125,\"z\":0.8690185546875,\"w\":0.0885009765625},"
+	"\"accelerometer\":[0.11279296875,-0.7958984375,0.61083984375],"
+	"\"gyroscope\":[-1.9375,2.0625,-0.6875]}]";
+
+static const uint64_t iterations = 200000;
+
+// keeps the optimizer from throwing away the results
+static volatile float sink;
+
+// Count every heap allocation in the process, so we can report allocations
+// per message. Nothing else is running while we benchmark.
+static std::atomic<uint64_t> allocations(0);
+
+void* operator new(size_t size){
+	allocations++;
+	void* p = malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept{
+	free(p);
+}
+
+// Synthetic messages, in the same shape Myo Connect sends them
+static string makeMessage(string type, int myo){
+
+	string event = "[\"event\",{\"type\":\"" + type + "\",\"timestamp\":\"1419549413446735\",\"myo\":" + ofToString(myo);
+
+	if (type == "orientation") {
+		event += ",\"orientation\":{\"x\":-0.4627685546875,\"y\":-0.14501953125,\"z\":0.8690185546875,\"w\":0.0885009765625},"
+			"\"accelerometer\":[0.11279296875,-0.7958984375,0.61083984375],"
+			"\"gyroscope\":[-1.9375,2.0625,-0.6875]";
+	}
+	else if (type == "paired") {
+		event += ",\"mac_address\":\"d4-6e-8c-00-00-00\",\"name\":\"Myo\",\"firmware_version\":[1,5,1970,2]";
+	}
+	else if (type == "connected") {
+		event += ",\"version\":[1,5,1970,2]";
+	}
+	else if (type == "arm_synced") {
+		event += ",\"arm\":\"right\",\"x_direction\":\"toward_wrist\",\"warmup_state\":\"warm\"";
+	}
+	else if (type == "pose") {
+		event += ",\"pose\":\"fist\"";
+	}
+	else if (type == "rssi") {
+		event += ",\"rssi\":-54";
+	}
+
+	return event + "}]";
+
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+
+	benchmarkOrientationParsing();
+	benchmarkMessages();
+	benchmarkEuler();
+	benchmarkUpdate();
+	benchmarkCommands();
+
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+	ofExit();
+
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkOrientationParsing(){
+
+	ofLogNotice() << "Orientation parsing, " << orientationMessage.size() << " byte message";
+
+	uint64_t start, allocated;
+
+	//
+	// ofxJSON, same as ofxLibwebsockets + the regular onMessage path
+	//
+	allocated = allocations;
+	start = ofGetElapsedTimeMicros();
+	for (uint64_t i = 0; i < iterations; i++) {
+
+		ofxJSONElement json;
+		json.parse(orientationMessage);
+
+		ofxJSONElement data = json[1];
+		ofxJSONElement accelerometer = data["accelerometer"];
+		ofxJSONElement gyroscope = data["gyroscope"];
+		ofxJSONElement quat = data["orientation"];
+
+		sink = data["myo"].asInt() + data["type"].asString().size()
+			+ accelerometer[0].asFloat() + accelerometer[1].asFloat() + accelerometer[2].asFloat()
+			+ gyroscope[0].asFloat() + gyroscope[1].asFloat() + gyroscope[2].asFloat()
+			+ quat["x"].asFloat() + quat["y"].asFloat() + quat["z"].asFloat() + quat["w"].asFloat();
+	}
+	report("ofxJSON parse + copies", iterations, ofGetElapsedTimeMicros() - start, allocations - allocated);
+
+	//
+	// ofxJSON copies only, since ofxLibwebsockets has already parsed the
+	// message by the time onMessage is called
+	//
+	ofxJSONElement parsed;
+	parsed.parse(orientationMessage);
+
+	allocated = allocations;
+	start = ofGetElapsedTimeMicros();
+	for (uint64_t i = 0; i < iterations; i++) {
+
+		ofxJSONElement data = parsed[1];
+		ofxJSONElement accelerometer = data["accelerometer"];
+		ofxJSONElement gyroscope = data["gyroscope"];
+		ofxJSONElement quat = data["orientation"];
+
+		sink = data["myo"].asInt() + data["type"].asString().size()
+			+ accelerometer[0].asFloat() + accelerometer[1].asFloat() + accelerometer[2].asFloat()
+			+ gyroscope[0].asFloat() + gyroscope[1].asFloat() + gyroscope[2].asFloat()
+			+ quat["x"].asFloat() + quat["y"].asFloat() + quat["z"].asFloat() + quat["w"].asFloat();
+	}
+	report("ofxJSON copies only", iterations, ofGetElapsedTimeMicros() - start, allocations - allocated);
+
+	//
+	// fast path
+	//
+	ofxMyoWebSockets::OrientationFrame frame;
+
+	allocated = allocations;
+	start = ofGetElapsedTimeMicros();
+	for (uint64_t i = 0; i < iterations; i++) {
+
+		ofxMyoWebSockets::parseOrientation(orientationMessage.data(), orientationMessage.size(), frame);
+
+		sink = frame.myo
+			+ frame.accel[0] + frame.accel[1] + frame.accel[2]
+			+ frame.gyro[0] + frame.gyro[1] + frame.gyro[2]
+			+ frame.quat[0] + frame.quat[1] + frame.quat[2] + frame.quat[3];
+	}
+	report("parseOrientation", iterations, ofGetElapsedTimeMicros() - start, allocations - allocated);
+
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkMessages(){
+
+	// processMessage() parses the JSON itself, which otherwise happens in
+	// ofxLibwebsockets before onMessage is called, so these numbers are the
+	// full cost of a message on the socket thread (minus the socket)
+	ofLogNotice() << "Connection::processMessage, per event type";
+
+	static const char* types[] = {
+		"paired", "connected", "arm_synced", "arm_unsynced", "pose",
+		"unlocked", "locked", "rssi", "orientation"
+	};
+
+	uint64_t messageIterations = iterations / 10;
+
+	for (int t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+
+		ofxMyoWebSockets::Connection myo;
+		string message = makeMessage(types[t], 0);
+
+		// the armband already exists, as it would in practice
+		myo.processMessage(makeMessage("paired", 0));
+
+		uint64_t allocated = allocations;
+		uint64_t start = ofGetElapsedTimeMicros();
+		for (uint64_t i = 0; i < messageIterations; i++) {
+			myo.processMessage(message);
+		}
+		report(types[t], messageIterations, ofGetElapsedTimeMicros() - start, allocations - allocated);
+	}
+
+	// what turning on stats costs
+	ofxMyoWebSockets::Connection myo;
+	myo.setStatsEnabled(true);
+	string message = makeMessage("orientation", 0);
+	myo.processMessage(message);
+
+	uint64_t allocated = allocations;
+	uint64_t start = ofGetElapsedTimeMicros();
+	for (uint64_t i = 0; i < messageIterations; i++) {
+		myo.processMessage(message);
+	}
+	report("orientation, stats enabled", messageIterations, ofGetElapsedTimeMicros() - start, allocations - allocated);
+
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkEuler(){
+
+	ofLogNotice() << "Quaternion to Euler angles";
+
+	// a history's worth of random orientations
+	ofxMyoWebSockets::EulerBatch batch;
+	for (int i = 0; i < 256; i++) {
+		ofVec4f q(ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1), ofRandom(-1, 1));
+		q.normalize();
+		batch.add(q.x, q.y, q.z, q.w);
+	}
+	batch.convert();
+
+	uint64_t rounds = iterations / 256;
+	uint64_t count = rounds * 256;
+
+	uint64_t allocated = allocations;
+	uint64_t start = ofGetElapsedTimeMicros();
+	for (uint64_t r = 0; r < rounds; r++) {
+		for (int i = 0; i < 256; i++) {
+			float x = batch.x[i], y = batch.y[i], z = batch.z[i], w = batch.w[i];
+			sink = atan2(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y))
+				+ asin(2.0f * (w * y - z * x))
+				+ atan2(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z));
+		}
+	}
+	report("atan2/asin", count, ofGetElapsedTimeMicros() - start, allocations - allocated, "quat");
+
+	allocated = allocations;
+	start = ofGetElapsedTimeMicros();
+	for (uint64_t r = 0; r < rounds; r++) {
+		batch.convert();
+		sink = batch.yaw[r & 255];
+	}
+	report("EulerBatch", count, ofGetElapsedTimeMicros() - start, allocations - allocated, "quat");
+
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkUpdate(){
+
+	// One orientation message per band per frame, then update(). Only the
+	// update() calls are timed, the messages would normally arrive on the
+	// socket thread.
+	ofLogNotice() << "Connection::update, one orientation message per armband per frame";
+
+	uint64_t frames = 2000;
+
+	for (int numArmbands = 1; numArmbands <= 64; numArmbands *= 2) {
+
+		ofxMyoWebSockets::Connection myo;
+		myo.setMaxArmbands(64);
+
+		vector<string> messages;
+		for (int i = 0; i < numArmbands; i++) {
+			myo.processMessage(makeMessage("paired", i));
+			myo.processMessage(makeMessage("arm_synced", i));
+			messages.push_back(makeMessage("orientation", i));
+		}
+		myo.update();
+
+		uint64_t micros = 0;
+		uint64_t allocated = 0;
+
+		for (uint64_t f = 0; f < frames; f++) {
+
+			for (int i = 0; i < numArmbands; i++) {
+				myo.processMessage(messages[i]);
+			}
+
+			uint64_t before = allocations;
+			uint64_t start = ofGetElapsedTimeMicros();
+			myo.update();
+			micros += ofGetElapsedTimeMicros() - start;
+			allocated += allocations - before;
+		}
+
+		report("update(), " + ofToString(numArmbands) + " armbands", frames, micros, allocated, "frame");
+	}
+
+}
+
+//--------------------------------------------------------------
+void ofApp::benchmarkCommands(){
+
+	// Not connected, so this is the cost of serializing and queueing each
+	// command rather than sending it. Every repeat is sent, not
+	// deduplicated, and the queue is flushed every few commands as update()
+	// would.
+	ofLogNotice() << "Connection::sendCommand";
+
+	ofxMyoWebSockets::Connection myo;
+	myo.setCommandDedupWindow(0);
+
+	uint64_t commandIterations = iterations / 10;
+
+	static const char* commands[] = { "vibrate", "notify_user_action", "request_rssi" };
+
+	for (int c = 0; c < 3; c++) {
+
+		uint64_t allocated = allocations;
+		uint64_t start = ofGetElapsedTimeMicros();
+		for (uint64_t i = 0; i < commandIterations; i++) {
+			if (c == 0) myo.vibrate(0, "short");
+			else if (c == 1) myo.notifyUserAction(0);
+			else myo.requestSignalStrength(0);
+
+			if (i % 8 == 7) myo.update();
+		}
+		report(commands[c], commandIterations, ofGetElapsedTimeMicros() - start, allocations - allocated);
+	}
+
+	// the same vibrate over and over, as happens when an app calls it every
+	// frame
+	myo.setCommandDedupWindow(0.1);
+
+	uint64_t allocated = allocations;
+	uint64_t start = ofGetElapsedTimeMicros();
+	for (uint64_t i = 0; i < commandIterations; i++) {
+		myo.vibrate(0, "short");
+		if (i % 8 == 7) myo.update();
+	}
+	report("vibrate, deduplicated", commandIterations, ofGetElapsedTimeMicros() - start, allocations - allocated);
+
+}
+
+//--------------------------------------------------------------
+void ofApp::report(string name, uint64_t iterations, uint64_t micros, uint64_t allocations, string unit){
+
+	double nsPerIteration = micros * 1000.0 / iterations;
+	double perSecond = micros > 0 ? iterations * 1000000.0 / micros : 0;
+
+	ofLogNotice() << "  " << name << ": "
+		<< ofToString(nsPerIteration, 1) << " ns/" << unit << ", "
+		<< ofToString(perSecond, 0) << " " << unit << "/s, "
+		<< ofToString((double)allocations / iterations, 1) << " allocs/" << unit;
+
+}
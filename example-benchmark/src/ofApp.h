@@ -0,0 +1,21 @@
+#pragma once
+
+#include "ofMain.h"
+
+#include "ofxMyoWebSockets.h"
+
+class ofApp : public ofBaseApp{
+
+public:
+	void setup();
+	void update();
+
+	void benchmarkOrientationParsing();
+	void benchmarkMessages();
+	void benchmarkEuler();
+	void benchmarkUpdate();
+	void benchmarkCommands();
+
+	void report(string name, uint64_t iterations, uint64_t micros, uint64_t allocations, string unit = "msg");
+
+};
@@ -0,0 +1,27 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( int argc, char* argv[] ){
+
+	ofApp* app = new ofApp();
+
+	// e.g. ./example-mockServer --bands 16 --rate 200 --port 10138 --no-client
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+
+		if (arg == "--bands" && hasValue) app->numArmbands = ofToInt(argv[++i]);
+		else if (arg == "--rate" && hasValue) app->orientationRate = ofToFloat(argv[++i]);
+		else if (arg == "--port" && hasValue) app->port = ofToInt(argv[++i]);
+		else if (arg == "--no-client") app->useClient = false;
+	}
+
+	// no window or GL context needed
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window, 1024, 768, OF_WINDOW);
+
+	ofRunApp(app);
+
+}
@@ -0,0 +1,100 @@
+#include "ofApp.h"
+
+//--------------------------------------------------------------
+ofApp::ofApp(){
+
+	numArmbands = 4;
+	orientationRate = 50;
+	port = 10138;
+	useClient = true;
+
+	received = 0;
+	latencyTotal = 0;
+	latencyMax = 0;
+
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+
+	server.setNumArmbands(numArmbands);
+	server.setOrientationRate(orientationRate);
+
+	if (!server.setup(port)) {
+		ofExit(1);
+		return;
+	}
+
+	ofLogNotice() << "Simulating " << numArmbands << " armbands at " << orientationRate << "Hz on port " << port;
+
+	// loop a client back to the server to measure throughput and latency.
+	// Without one, point any other app at this machine instead.
+	if (useClient) {
+		ofAddListener(myo.orientationEvent, this, &ofApp::onOrientation);
+		myo.setMaxArmbands(MAX(numArmbands, 16));
+		myo.connect("localhost", port, true);
+	}
+
+	lastReport = ofGetElapsedTimef();
+	lastSent = 0;
+
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+	myo.update();
+
+	float now = ofGetElapsedTimef();
+	if (now - lastReport < 1.0f) return;
+
+	float elapsed = now - lastReport;
+	lastReport = now;
+
+	unsigned int sent = server.getSentCount();
+
+	stringstream report;
+	report << "clients: " << server.getNumClients()
+		<< ", sent: " << ofToString((sent - lastSent) / elapsed, 0) << " msg/s";
+
+	lastSent = sent;
+
+	if (useClient) {
+		uint64_t count = received.exchange(0);
+		uint64_t total = latencyTotal.exchange(0);
+		uint64_t worst = latencyMax.exchange(0);
+
+		report << ", received: " << ofToString(count / elapsed, 0) << " orientation msg/s"
+			<< ", latency: " << (count ? total / count : 0) << "us avg, " << worst << "us max";
+	}
+
+	ofLogNotice() << report.str();
+
+}
+
+//--------------------------------------------------------------
+void ofApp::exit(){
+
+	if (useClient) {
+		ofRemoveListener(myo.orientationEvent, this, &ofApp::onOrientation);
+	}
+
+	server.close();
+
+}
+
+//--------------------------------------------------------------
+void ofApp::onOrientation(ofxMyoWebSockets::Armband& armband){
+
+	// Armband::timestamp is whatever the server sent, which for the mock
+	// server is on the same clock as getTimestamp()
+	uint64_t now = ofxMyoWebSockets::MockServer::getTimestamp();
+	uint64_t latency = now > armband.timestamp ? now - armband.timestamp : 0;
+
+	received++;
+	latencyTotal += latency;
+
+	uint64_t worst = latencyMax;
+	while (latency > worst && !latencyMax.compare_exchange_weak(worst, latency));
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ofMain.h"
+
+#include "ofxMyoWebSockets.h"
+#include "ofxMyoWebSocketsMockServer.h"
+
+class ofApp : public ofBaseApp{
+
+public:
+	ofApp();
+
+	void setup();
+	void update();
+	void exit();
+
+	void onOrientation(ofxMyoWebSockets::Armband& armband);
+
+	// set from the command line, see main.cpp
+	int numArmbands;
+	float orientationRate;
+	int port;
+	bool useClient;
+
+	ofxMyoWebSockets::MockServer server;
+	ofxMyoWebSockets::Connection myo;
+
+	// written on the socket thread, read once a second on the main thread
+	std::atomic<uint64_t> received;
+	std::atomic<uint64_t> latencyTotal;
+	std::atomic<uint64_t> latencyMax;
+
+	float lastReport;
+	unsigned int lastSent;
+
+};
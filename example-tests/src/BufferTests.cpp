@@ -0,0 +1,213 @@
+#include "Tests.h"
+#include "ofxMyoWebSockets.h"
+
+#include <thread>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	//--------------------------------------------------------------
+	string makeOrientation(int myo, float x){
+		return "[\"event\",{\"type\":\"orientation\",\"timestamp\":\"1\",\"myo\":" + ofToString(myo) + ","
+			"\"orientation\":{\"x\":" + ofToString(x) + ",\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0,0]}]";
+	}
+
+	//--------------------------------------------------------------
+	void testTripleBuffer(){
+
+		TripleBuffer<int> buffer;
+		CHECK(!buffer.consume());
+
+		buffer.back() = 1;
+		buffer.publish();
+		CHECK(buffer.consume() && buffer.front() == 1);
+		CHECK(!buffer.consume() && buffer.front() == 1);
+
+		// the consumer only ever sees the latest
+		buffer.back() = 2;
+		buffer.publish();
+		buffer.back() = 3;
+		buffer.publish();
+		CHECK(buffer.consume() && buffer.front() == 3);
+
+		// and never a half-written one, from another thread
+		struct Pair { int a, b; };
+		TripleBuffer<Pair> pairs;
+		const int count = 200000;
+
+		std::thread producer([&]{
+			for (int i = 1; i <= count; i++) {
+				pairs.back().a = i;
+				pairs.back().b = -i;
+				pairs.publish();
+			}
+		});
+
+		int last = 0;
+		bool torn = false, backwards = false;
+		while (last < count) {
+			if (!pairs.consume()) continue;
+			const Pair& pair = pairs.front();
+			torn |= pair.a != -pair.b;
+			backwards |= pair.a <= last;
+			last = pair.a;
+		}
+		producer.join();
+
+		CHECK(!torn);
+		CHECK(!backwards);
+
+	}
+
+	//--------------------------------------------------------------
+	void testSlotPool(){
+
+		SlotPool<int> pool(4);
+
+		// with a table of 8, some of these are bound to collide
+		int ids[4] = { 7, 7 + 1024, 7 + 2048, 7 + 4096 };
+		for (int i = 0; i < 4; i++) {
+			int* value = pool.acquire(ids[i]);
+			if (CHECK(value)) *value = i;
+		}
+		CHECK(pool.size() == 4);
+		CHECK(pool.acquire(99) == NULL);
+		CHECK(pool.acquire(ids[2]) == pool.find(ids[2]));
+
+		SlotHandle handle = pool.getHandle(ids[1]);
+		CHECK(handle.isValid() && pool.get(handle) == pool.find(ids[1]));
+		CHECK(!pool.getHandle(99).isValid());
+
+		// the rest are still found once one in the middle of the run goes
+		CHECK(pool.release(ids[1]));
+		CHECK(!pool.release(ids[1]));
+		CHECK(pool.find(ids[1]) == NULL);
+		CHECK(pool.find(ids[0]) && *pool.find(ids[0]) == 0);
+		CHECK(pool.find(ids[2]) && *pool.find(ids[2]) == 2);
+		CHECK(pool.find(ids[3]) && *pool.find(ids[3]) == 3);
+		CHECK(pool.size() == 3);
+
+		// a handle to it stays dead, even once the slot's reused
+		CHECK(pool.get(handle) == NULL);
+		int* reused = pool.acquire(99);
+		if (CHECK(reused)) {
+			CHECK(*reused == 0);
+			CHECK(pool.getHandle(99).slot == handle.slot);
+			CHECK(pool.get(handle) == NULL);
+			CHECK(pool.get(pool.getHandle(99)) == reused);
+		}
+
+		// in the order they came along
+		CHECK(*pool[0] == 0 && *pool[1] == 2 && *pool[2] == 3);
+
+		pool.clear();
+		CHECK(pool.size() == 0 && pool.find(ids[0]) == NULL);
+
+	}
+
+	//--------------------------------------------------------------
+	// Each buffer only copies the armbands that changed since it was last
+	// filled, so every armband has to be right after every update()
+	void testSnapshots(){
+
+		Connection myo;
+
+		bool right = true;
+		float sent[3] = { 0, 0, 0 };
+
+		for (int i = 0; i < 30; i++) {
+			int id = (i * 7) % 3;
+			sent[id] = (i + 1) / 100.0f;
+			myo.processMessage(makeOrientation(id, sent[id]));
+
+			// now and then more than one publish per update()
+			if (i % 4 == 0) continue;
+			myo.update();
+
+			for (int j = 0; j < 3; j++) {
+				Armband* armband = myo.findArmband(j);
+				if (!armband) {
+					right &= sent[j] == 0;
+					continue;
+				}
+				right &= fabs(armband->quat.x() - sent[j]) < 1e-5f;
+			}
+		}
+
+		CHECK(right);
+		CHECK(myo.armbands.size() == 3);
+
+		// the order they came along in
+		if (CHECK(myo.armbands.size() == 3)) {
+			CHECK(myo.armbands[0]->id == 0 && myo.armbands[1]->id == 1 && myo.armbands[2]->id == 2);
+		}
+
+	}
+
+#ifndef _WIN32
+	//--------------------------------------------------------------
+	// Once the connection's started, settings go to the socket thread
+	// through a queue. setSharedMemory() waits for it, so the armbands are
+	// there as soon as it returns, without another message.
+	void testConfigure(){
+
+		string name = "/ofxMyoWebSocketsConfigTests";
+
+		SharedMemoryPublisher publisher;
+		if (!CHECK(publisher.open(name, 16, 64))) return;
+
+		SharedMemoryReader reader;
+		if (!CHECK(reader.open(name))) return;
+
+		Connection myo;
+		myo.processMessage(makeOrientation(4, 0.5f));
+
+		myo.setSharedMemory(&publisher);
+		int slot = reader.find(4);
+		SharedArmbandState state;
+		if (CHECK(slot >= 0 && reader.read(slot, state))) {
+			CHECK(fabs(state.quat[0] - 0.5f) < 1e-5f);
+		}
+
+		myo.processMessage(makeOrientation(4, 0.25f));
+		if (CHECK(reader.read(slot, state))) {
+			CHECK(fabs(state.quat[0] - 0.25f) < 1e-5f);
+		}
+
+		// and nothing more once it's unset
+		myo.setSharedMemory(NULL);
+		unsigned int published = reader.getPublishCount();
+		myo.processMessage(makeOrientation(4, 0.125f));
+		CHECK(reader.getPublishCount() == published);
+
+		// the rest apply in order, before the next message
+		GesturePolicy policy;
+		policy.requiresUnlock = true;
+		myo.setGesturePolicy(policy);
+		myo.processMessage(makeOrientation(5, 0));
+		myo.update();
+
+		Armband* armband = myo.findArmband(5);
+		if (CHECK(armband)) CHECK(!armband->unlocked);
+
+		policy.requiresUnlock = false;
+		myo.setGesturePolicy(policy);
+		CHECK(tests::waitFor([&]{ return armband && armband->unlocked; }, [&]{ myo.update(); }, 1));
+
+	}
+#endif
+
+}
+
+//--------------------------------------------------------------
+void tests::testBuffers(){
+
+	testTripleBuffer();
+	testSlotPool();
+	testSnapshots();
+#ifndef _WIN32
+	testConfigure();
+#endif
+
+}
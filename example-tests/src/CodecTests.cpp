@@ -0,0 +1,283 @@
+#include "Tests.h"
+#include "ofxMyoWebSocketsCodec.h"
+
+#include <random>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	//--------------------------------------------------------------
+	// Random orientations and readings within the Myo's ranges, the same
+	// every run
+	vector<Sample> makeSamples(int count, uint32_t seed){
+
+		std::mt19937 random(seed);
+		std::normal_distribution<float> normal;
+		std::uniform_real_distribution<float> accel(-15.9f, 15.9f);
+		std::uniform_real_distribution<float> gyro(-2000.0f, 2000.0f);
+		std::uniform_int_distribution<int> step(1000, 30000);
+
+		vector<Sample> samples(count);
+		uint64_t timestamp = 1000000;
+
+		for (int i = 0; i < count; i++) {
+			Sample& sample = samples[i];
+			sample.myo = i % 3;
+
+			timestamp += step(random);
+			sample.timestamp = timestamp;
+
+			float length = 0;
+			for (int j = 0; j < 4; j++) {
+				sample.quat[j] = normal(random);
+				length += sample.quat[j] * sample.quat[j];
+			}
+			for (int j = 0; j < 4; j++) {
+				sample.quat[j] /= sqrtf(length);
+			}
+
+			for (int j = 0; j < 3; j++) {
+				sample.accel[j] = accel(random);
+				sample.gyro[j] = gyro(random);
+			}
+		}
+
+		return samples;
+
+	}
+
+	//--------------------------------------------------------------
+	// Degrees between two orientations, q and -q being the same one. From
+	// the distance between them rather than acos() of their dot product,
+	// which is too coarse this close to 1.
+	float getAngle(const float a[4], const float b[4]){
+		double dot = 0;
+		for (int i = 0; i < 4; i++) dot += a[i] * b[i];
+
+		double sign = dot < 0 ? -1 : 1;
+		double distance = 0;
+		for (int i = 0; i < 4; i++) distance += (a[i] - sign * b[i]) * (a[i] - sign * b[i]);
+
+		return 4 * asin(MIN(sqrt(distance) / 2, 1.0)) * RAD_TO_DEG;
+	}
+
+	//--------------------------------------------------------------
+	void testRoundTrip(int quatBits, float maxAngle){
+
+		vector<Sample> samples = makeSamples(1000, quatBits);
+
+		// a few awkward ones: no rotation, half turns, large ids
+		float identity[4] = { 0, 0, 0, 1 };
+		float halfTurn[4] = { 1, 0, 0, 0 };
+		float negative[4] = { 0, -0.70710678f, 0, -0.70710678f };
+		memcpy(samples[0].quat, identity, sizeof(identity));
+		memcpy(samples[1].quat, halfTurn, sizeof(halfTurn));
+		memcpy(samples[2].quat, negative, sizeof(negative));
+		samples[3].myo = 300;
+		samples[4].myo = 100000;
+
+		vector<uint8_t> buffer(SampleEncoder::getMaxSize(samples.size()));
+		SampleEncoder encoder(quatBits);
+		size_t size = encoder.encode(&samples[0], samples.size(), &buffer[0]);
+		CHECK(size <= buffer.size());
+
+		vector<Sample> decoded(samples.size() + 1);
+		SampleDecoder decoder(quatBits);
+		size_t used = 0;
+		int count = decoder.decode(&buffer[0], size, &decoded[0], decoded.size(), &used);
+
+		if (!CHECK(count == samples.size())) return;
+		CHECK(used == size);
+
+		float worstAngle = 0, worstAccel = 0, worstGyro = 0;
+		int wrong = 0;
+
+		for (int i = 0; i < count; i++) {
+			if (decoded[i].myo != samples[i].myo || decoded[i].timestamp != samples[i].timestamp) wrong++;
+
+			worstAngle = MAX(worstAngle, getAngle(decoded[i].quat, samples[i].quat));
+
+			for (int j = 0; j < 3; j++) {
+				worstAccel = MAX(worstAccel, fabsf(decoded[i].accel[j] - samples[i].accel[j]));
+				worstGyro = MAX(worstGyro, fabsf(decoded[i].gyro[j] - samples[i].gyro[j]));
+			}
+		}
+
+		CHECK(wrong == 0);
+		CHECK(worstAngle < maxAngle);
+
+		// to within half a step of the fixed point
+		CHECK(worstAccel <= 0.5f / 2048 + 1e-5f);
+		CHECK(worstGyro <= 0.5f / 16 + 1e-3f);
+
+		ofLogNotice("tests") << quatBits << " bit quaternions: " << worstAngle << " degrees at worst, "
+			<< (float)size / samples.size() << " bytes a sample";
+
+		// one at a time comes out the same as all at once, and no sample is
+		// bigger than it's meant to be
+		encoder.reset();
+		vector<uint8_t> single(SampleEncoder::maxSampleSize);
+		size_t offset = 0;
+		bool same = true;
+
+		for (int i = 0; i < samples.size(); i++) {
+			size_t length = encoder.encode(&samples[i], 1, &single[0]);
+			CHECK(length <= SampleEncoder::maxSampleSize);
+			same &= memcmp(&single[0], &buffer[offset], length) == 0;
+			offset += length;
+		}
+
+		CHECK(same);
+		CHECK(offset == size);
+
+	}
+
+	//--------------------------------------------------------------
+	// Out of range readings are clamped rather than wrapped
+	void testClamping(){
+
+		Sample sample = {};
+		sample.quat[3] = 1;
+		sample.accel[0] = 100;
+		sample.accel[1] = -100;
+		sample.gyro[2] = 1e6f;
+
+		uint8_t buffer[SampleEncoder::maxSampleSize];
+		SampleEncoder encoder;
+		size_t size = encoder.encode(&sample, 1, buffer);
+
+		Sample decoded;
+		SampleDecoder decoder;
+		CHECK(decoder.decode(buffer, size, &decoded, 1) == 1);
+		CHECK(decoded.accel[0] > 15.9f);
+		CHECK(decoded.accel[1] < -15.9f);
+		CHECK(decoded.gyro[2] > 2000);
+
+	}
+
+	//--------------------------------------------------------------
+	// Only whole samples are decoded, so the rest can be carried over to
+	// the next call, e.g. as more of a file or socket comes in
+	void testTruncated(){
+
+		vector<Sample> samples = makeSamples(10, 1);
+		samples[5].myo = 1000;
+
+		// where each sample ends
+		SampleEncoder encoder;
+		vector<uint8_t> buffer(SampleEncoder::getMaxSize(samples.size()));
+		vector<size_t> ends;
+		size_t size = 0;
+
+		for (int i = 0; i < samples.size(); i++) {
+			size += encoder.encode(&samples[i], 1, &buffer[size]);
+			ends.push_back(size);
+		}
+
+		Sample decoded[16];
+		int wrong = 0;
+
+		for (size_t length = 0; length <= size; length++) {
+
+			int whole = 0;
+			while (whole < ends.size() && ends[whole] <= length) whole++;
+
+			SampleDecoder decoder;
+			size_t used = 12345;
+			int count = decoder.decode(&buffer[0], length, decoded, 16, &used);
+
+			if (count != whole || used != (whole ? ends[whole - 1] : 0)) {
+				wrong++;
+				continue;
+			}
+
+			// then the rest, carrying on from the same decoder
+			int rest = decoder.decode(&buffer[used], size - used, decoded + count, 16 - count, &used);
+			if (count + rest != samples.size()) {
+				wrong++;
+				continue;
+			}
+
+			for (int i = 0; i < samples.size(); i++) {
+				if (decoded[i].myo != samples[i].myo || decoded[i].timestamp != samples[i].timestamp) wrong++;
+			}
+		}
+
+		CHECK(wrong == 0);
+
+		// at most maxSamples, even with more in the buffer
+		SampleDecoder decoder;
+		size_t used;
+		CHECK(decoder.decode(&buffer[0], size, decoded, 3, &used) == 3);
+		CHECK(used == ends[2]);
+		CHECK(decoder.decode(&buffer[0], size, decoded, 0, &used) == 0);
+		CHECK(used == 0);
+
+		// without used
+		CHECK(decoder.decode(&buffer[0], ends[1] - 1, decoded, 16) == 1);
+
+	}
+
+	//--------------------------------------------------------------
+	// Samples merged from several armbands or clocks needn't be in order
+	void testTimestamps(){
+
+		uint64_t timestamps[] = { 1000000, 1000020, 999990, 5, 0, 1ULL << 40, 3, (1ULL << 40) + 1, 1ULL << 63, 7 };
+		int count = sizeof(timestamps) / sizeof(timestamps[0]);
+
+		vector<Sample> samples = makeSamples(count, 2);
+		for (int i = 0; i < count; i++) {
+			samples[i].timestamp = timestamps[i];
+		}
+
+		uint8_t buffer[SampleEncoder::maxSampleSize * 16];
+		SampleEncoder encoder;
+		size_t size = encoder.encode(&samples[0], count, buffer);
+
+		Sample decoded[16];
+		SampleDecoder decoder;
+		if (!CHECK(decoder.decode(buffer, size, decoded, 16) == count)) return;
+
+		for (int i = 0; i < count; i++) {
+			CHECK(decoded[i].timestamp == timestamps[i]);
+		}
+
+		// a small step back takes no more room than a small step forward
+		Sample step = samples[0];
+		size_t forward, back;
+
+		encoder.reset();
+		step.timestamp = 1000;
+		encoder.encode(&step, 1, buffer);
+		step.timestamp = 1100;
+		forward = encoder.encode(&step, 1, buffer);
+
+		encoder.reset();
+		encoder.encode(&step, 1, buffer);
+		step.timestamp = 1000;
+		back = encoder.encode(&step, 1, buffer);
+
+		CHECK(back == forward);
+
+		// reset() starts a new stream on both ends
+		encoder.reset();
+		decoder.reset();
+		size = encoder.encode(&samples[0], 1, buffer);
+		CHECK(decoder.decode(buffer, size, decoded, 1) == 1);
+		CHECK(decoded[0].timestamp == timestamps[0]);
+
+	}
+
+}
+
+//--------------------------------------------------------------
+void tests::testCodec(){
+
+	testRoundTrip(48, 0.01f);
+	testRoundTrip(32, 0.25f);
+	testClamping();
+	testTruncated();
+	testTimestamps();
+
+}
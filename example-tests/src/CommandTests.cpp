@@ -0,0 +1,147 @@
+#include "Tests.h"
+#include "ofxJSON.h"
+#include "ofxMyoWebSocketsCommandQueue.h"
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	// Everything the writer thread has sent so far
+	struct Sent {
+
+		void add(const string& message){
+			std::lock_guard<std::mutex> lock(mutex);
+			messages.push_back(message);
+		}
+
+		vector<string> get(){
+			std::lock_guard<std::mutex> lock(mutex);
+			return messages;
+		}
+
+		std::mutex		mutex;
+		vector<string>	messages;
+
+	};
+
+	//--------------------------------------------------------------
+	string serialize(int myoID, const string& command, const string& type){
+		char text[CommandQueue::maxLength];
+		size_t length = CommandQueue::serialize(text, sizeof(text), myoID, command, type);
+		return string(text, length);
+	}
+
+	//--------------------------------------------------------------
+	// The same as the JSON tree Connection used to build
+	void testSerialize(){
+
+		const char* types[] = { "short", "with \"quotes\" and \\", "tab\tand\nnewline" };
+		bool same = true;
+
+		for (int i = 0; i < 3; i++) {
+			ofxJSONElement json;
+			json[0] = "command";
+			json[1]["command"] = "vibrate";
+			json[1]["myo"] = 2;
+			json[1]["type"] = types[i];
+
+			ofxJSONElement parsed;
+			same &= parsed.parse(serialize(2, "vibrate", types[i])) && parsed == json;
+		}
+		CHECK(same);
+
+		CHECK(serialize(-1, "set_locking_policy", "none") == "[\"command\",{\"command\":\"set_locking_policy\",\"type\":\"none\"}]");
+		CHECK(serialize(0, "vibrate", string(CommandQueue::maxLength, 'x')).empty());
+
+	}
+
+	//--------------------------------------------------------------
+	void testDedup(){
+
+		CommandQueue commands;
+		commands.setDedupWindow(100000);
+
+		CHECK(commands.push(0, "vibrate", "short", 0));
+		CHECK(!commands.push(0, "vibrate", "short", 50000));
+
+		// only the very same command to the same armband
+		CHECK(commands.push(1, "vibrate", "short", 50000));
+		CHECK(commands.push(0, "vibrate", "long", 50000));
+		CHECK(commands.push(0, "request_rssi", "", 50000));
+		CHECK(!commands.push(0, "request_rssi", "", 60000));
+
+		// order sensitive ones always go through
+		CHECK(commands.push(0, "lock", "", 60000));
+		CHECK(commands.push(0, "lock", "", 60000));
+
+		// and once the window's up, it's sent again
+		CHECK(commands.push(0, "vibrate", "short", 100000));
+		CHECK(commands.getDeduplicatedCount() == 2);
+
+		// with no window, everything
+		commands.setDedupWindow(0);
+		CHECK(commands.push(0, "vibrate", "short", 100001));
+		CHECK(commands.getDeduplicatedCount() == 2);
+
+		// too long to serialize
+		CHECK(!commands.push(0, "vibrate", string(CommandQueue::maxLength, 'x'), 200000));
+		CHECK(commands.getDroppedCount() == 1);
+
+	}
+
+	//--------------------------------------------------------------
+	void testFlush(){
+
+		Sent sent;
+		CommandQueue commands;
+		commands.setDedupWindow(0);
+
+		// queued up until the writer thread starts, and the first flush()
+		// after that
+		commands.push(0, "vibrate", "short", 0);
+		commands.push(0, "unlock", "hold", 0);
+		commands.flush();
+
+		commands.start([&](const string& message){ sent.add(message); });
+		CHECK(!tests::waitFor([&]{ return !sent.get().empty(); }, []{}, 0.1f));
+
+		commands.flush();
+		CHECK(tests::waitFor([&]{ return sent.get().size() == 2; }, []{}, 1));
+
+		// in order, batch after batch
+		for (int i = 0; i < 100; i++) {
+			commands.push(i, "vibrate", "short", 1);
+			if (i % 10 == 9) commands.flush();
+		}
+		CHECK(tests::waitFor([&]{ return sent.get().size() == 102; }, []{}, 1));
+
+		vector<string> messages = sent.get();
+		if (CHECK(messages.size() == 102)) {
+			CHECK(messages[0] == serialize(0, "vibrate", "short"));
+			CHECK(messages[1] == serialize(0, "unlock", "hold"));
+
+			bool ordered = true;
+			for (int i = 0; i < 100; i++) ordered &= messages[i + 2] == serialize(i, "vibrate", "short");
+			CHECK(ordered);
+		}
+		CHECK(commands.getSentCount() == 102);
+
+		// anything over capacity between flushes is dropped
+		for (int i = 0; i < CommandQueue::capacity + 10; i++) commands.push(i, "vibrate", "short", 2);
+		CHECK(commands.getDroppedCount() == 10);
+
+		commands.stop();
+		CHECK(!commands.isRunning());
+
+	}
+
+}
+
+//--------------------------------------------------------------
+void tests::testCommands(){
+
+	testSerialize();
+	testDedup();
+	testFlush();
+
+}
@@ -0,0 +1,647 @@
+#include "Tests.h"
+#include "ofxMyoWebSockets.h"
+#include "ofxMyoWebSocketsHub.h"
+#include "ofxMyoWebSocketsMockServer.h"
+#include "ofxMyoWebSocketsOscBridge.h"
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	// out of the way of a real Myo Connect on 10138
+	const int port = 10148;
+	const int secondPort = 10149;
+	const int oscPort = 10150;
+
+	// Every pose and lock event, with the armband's state and the thread
+	// it was fired from as they were at the time
+	struct EventLog {
+
+		struct Entry {
+			string			type;
+			Pose			pose;
+			bool			unlocked;
+			bool			poseConfirmed;
+			int				host;
+			int				id;
+			bool			mainThread;
+		};
+
+		EventLog(){
+			mainThread = std::this_thread::get_id();
+		}
+
+		void add(string type, const Armband& armband){
+			Entry entry = { type, armband.pose, armband.unlocked, armband.poseConfirmed, armband.host, armband.id, std::this_thread::get_id() == mainThread };
+			std::lock_guard<std::mutex> lock(mutex);
+			entries.push_back(entry);
+		}
+
+		void onPoseStarted(Armband& armband) { add("poseStarted", armband); }
+		void onPoseConfirmed(Armband& armband) { add("poseConfirmed", armband); }
+		void onUnlocked(Armband& armband) { add("unlocked", armband); }
+		void onLocked(Armband& armband) { add("locked", armband); }
+		void onRssiReceived(Armband& armband) { add("rssi", armband); }
+		void onDisconnected(Armband& armband) { add("disconnected", armband); }
+
+		vector<Entry> get(){
+			std::lock_guard<std::mutex> lock(mutex);
+			return entries;
+		}
+
+		void clear(){
+			std::lock_guard<std::mutex> lock(mutex);
+			entries.clear();
+		}
+
+		bool contains(string type, Pose pose){
+			std::lock_guard<std::mutex> lock(mutex);
+			for (int i = 0; i < entries.size(); i++) {
+				if (entries[i].type == type && entries[i].pose == pose) return true;
+			}
+			return false;
+		}
+
+		int count(string type){
+			std::lock_guard<std::mutex> lock(mutex);
+			int count = 0;
+			for (int i = 0; i < entries.size(); i++) {
+				if (entries[i].type == type) count++;
+			}
+			return count;
+		}
+
+		std::thread::id		mainThread;
+		std::mutex			mutex;
+		vector<Entry>		entries;
+
+	};
+
+	//--------------------------------------------------------------
+	template<class Source>
+	void addListeners(Source& source, EventLog& log){
+		ofAddListener(source.poseStartedEvent, &log, &EventLog::onPoseStarted);
+		ofAddListener(source.poseConfirmedEvent, &log, &EventLog::onPoseConfirmed);
+		ofAddListener(source.unlockedEvent, &log, &EventLog::onUnlocked);
+		ofAddListener(source.lockedEvent, &log, &EventLog::onLocked);
+		ofAddListener(source.rssiReceivedEvent, &log, &EventLog::onRssiReceived);
+	}
+
+	//--------------------------------------------------------------
+	template<class Source>
+	void removeListeners(Source& source, EventLog& log){
+		ofRemoveListener(source.poseStartedEvent, &log, &EventLog::onPoseStarted);
+		ofRemoveListener(source.poseConfirmedEvent, &log, &EventLog::onPoseConfirmed);
+		ofRemoveListener(source.unlockedEvent, &log, &EventLog::onUnlocked);
+		ofRemoveListener(source.lockedEvent, &log, &EventLog::onLocked);
+		ofRemoveListener(source.rssiReceivedEvent, &log, &EventLog::onRssiReceived);
+	}
+
+	//--------------------------------------------------------------
+	bool checkEntry(const vector<EventLog::Entry>& entries, int index, string type, Pose pose, bool unlocked){
+
+		if (!CHECK(index < entries.size())) return false;
+
+		const EventLog::Entry& entry = entries[index];
+		bool passed = CHECK(entry.type == type) & CHECK(entry.pose == pose) & CHECK(entry.unlocked == unlocked);
+
+		if (!passed) {
+			ofLogError("tests") << "event " << index << " was " << entry.type << " " << toString(entry.pose) << " unlocked " << entry.unlocked
+				<< ", expected " << type << " " << toString(pose) << " unlocked " << unlocked;
+		}
+
+		return passed;
+
+	}
+
+	//--------------------------------------------------------------
+	// Pose confirmation and locking, with events fired straight from the
+	// socket and scheduler threads, or queued. Whatever the timing,
+	// listeners see every event in order, with the armband as it was when
+	// it happened.
+	void testEventOrder(bool queued){
+
+		MockServer server;
+		server.setOrientationRate(0);
+		server.setPoseRate(0);
+		server.setRssiRate(0);
+		CHECK(server.setup(port));
+
+		// declared before the connection, so it outlives the socket thread
+		EventLog log;
+
+		Connection myo;
+		myo.setQueuedEvents(queued);
+		myo.setRequiresUnlock(true);
+		myo.setMinimumGestureDuration(0.1);
+		myo.setUnlockTimeout(1.0);
+		addListeners(myo, log);
+		myo.connect("localhost", port);
+
+		auto update = [&]{ myo.update(); };
+
+		// connected once the signal strength asked for on connecting is in
+		if (!CHECK(tests::waitFor([&]{ return log.count("rssi") == 1; }, update))) {
+			removeListeners(myo, log);
+			return;
+		}
+
+		log.clear();
+		unsigned int commands = server.getCommandCount();
+
+		// locked to begin with, a double tap unlocks straight away and is
+		// confirmed once it's been held
+		server.simulatePose(0, "double_tap");
+		CHECK(tests::waitFor([&]{ return log.contains("poseConfirmed", POSE_DOUBLE_TAP); }, update));
+
+		// rest counts right away, anything else once it's been held, after
+		// which it's locked again
+		server.simulatePose(0, "rest");
+		CHECK(tests::waitFor([&]{ return log.contains("poseConfirmed", POSE_REST); }, update));
+
+		server.simulatePose(0, "fist");
+		CHECK(tests::waitFor([&]{ return log.contains("locked", POSE_REST); }, update));
+
+		vector<EventLog::Entry> entries = log.get();
+		checkEntry(entries, 0, "poseStarted", POSE_DOUBLE_TAP, false);
+		checkEntry(entries, 1, "unlocked", POSE_DOUBLE_TAP, true);
+		checkEntry(entries, 2, "poseConfirmed", POSE_DOUBLE_TAP, true);
+		checkEntry(entries, 3, "poseStarted", POSE_REST, true);
+		checkEntry(entries, 4, "poseConfirmed", POSE_REST, true);
+		checkEntry(entries, 5, "poseStarted", POSE_FIST, true);
+		checkEntry(entries, 6, "poseConfirmed", POSE_FIST, true);
+		checkEntry(entries, 7, "locked", POSE_REST, false);
+		CHECK(entries.size() == 8);
+
+		for (int i = 0; i < entries.size(); i++) {
+			CHECK(entries[i].poseConfirmed == (entries[i].type == "poseConfirmed"));
+			CHECK(entries[i].mainThread == queued);
+		}
+
+		// held while locked, thumb to pinky unlocks and counts, and it locks
+		// again on its own once the timeout's up
+		log.clear();
+
+		server.simulatePose(0, "thumb_to_pinky");
+		CHECK(tests::waitFor([&]{ return log.contains("poseConfirmed", POSE_THUMB_TO_PINKY); }, update));
+
+		server.simulatePose(0, "rest");
+		CHECK(tests::waitFor([&]{ return log.contains("locked", POSE_REST); }, update));
+
+		entries = log.get();
+		checkEntry(entries, 0, "poseStarted", POSE_THUMB_TO_PINKY, false);
+		checkEntry(entries, 1, "unlocked", POSE_THUMB_TO_PINKY, true);
+		checkEntry(entries, 2, "poseConfirmed", POSE_THUMB_TO_PINKY, true);
+		checkEntry(entries, 3, "poseStarted", POSE_REST, true);
+		checkEntry(entries, 4, "poseConfirmed", POSE_REST, true);
+		checkEntry(entries, 5, "locked", POSE_REST, false);
+		CHECK(entries.size() == 6);
+
+		if (entries.size() == 6) CHECK(entries[5].mainThread == queued);
+
+		// state as of the next update() matches the last event, which may
+		// have come from another thread since the last one
+		myo.update();
+		Armband* armband = myo.getArmband(0);
+		CHECK(armband->pose == POSE_REST);
+		CHECK(!armband->unlocked);
+
+		// the double tap and thumb to pinky each asked for a vibrate and
+		// notify_user_action, and the timeout for another notify_user_action
+		CHECK(tests::waitFor([&]{ return server.getCommandCount() - commands == 5; }, update));
+
+		removeListeners(myo, log);
+
+	}
+
+	//--------------------------------------------------------------
+	// Two hosts, with overlapping Myo ids
+	void testHub(){
+
+		MockServer first, second;
+		first.setNumArmbands(2);
+		second.setNumArmbands(1);
+
+		for (MockServer* server : { &first, &second }) {
+			server->setOrientationRate(0);
+			server->setPoseRate(0);
+			server->setRssiRate(0);
+		}
+
+		CHECK(first.setup(port));
+		CHECK(second.setup(secondPort));
+
+		EventLog log;
+
+		Hub hub;
+		CHECK(hub.addHost("localhost", port) == 0);
+		CHECK(hub.addHost("localhost", secondPort) == 1);
+		addListeners(hub, log);
+		hub.connect();
+
+		auto update = [&]{ hub.update(); };
+
+		auto settled = [&]{ return hub.armbands.size() == 3 && log.count("rssi") >= 3; };
+		if (!CHECK(tests::waitFor(settled, update))) {
+			removeListeners(hub, log);
+			return;
+		}
+
+		// signal strength is asked for on connecting, more than once if the
+		// armbands beat the socket opening, so let the answers come in. Also
+		// gets past the window in which repeats are dropped.
+		float start = ofGetElapsedTimef();
+		while (ofGetElapsedTimef() - start < 0.25f) {
+			update();
+			ofSleepMillis(1);
+		}
+
+		log.clear();
+
+		// sorted by host, then id
+		CHECK(hub.armbands[0]->host == 0 && hub.armbands[0]->id == 0);
+		CHECK(hub.armbands[1]->host == 0 && hub.armbands[1]->id == 1);
+		CHECK(hub.armbands[2]->host == 1 && hub.armbands[2]->id == 0);
+
+		Armband* armband = hub.armbands[2];
+		CHECK(Hub::getGlobalId(hub.armbands[0]) == 0);
+		CHECK(Hub::getGlobalId(hub.armbands[1]) == 1);
+		CHECK(Hub::getGlobalId(armband) == 1000);
+		CHECK(hub.getArmband(1000) == armband);
+		CHECK(hub.getArmband(1, 0) == armband);
+		CHECK(hub.getArmband(0, 0) == hub.armbands[0]);
+		CHECK(hub.getArmband(2000) == NULL);
+
+		// looking doesn't make up armbands that aren't there
+		CHECK(hub.getArmband(5) == NULL);
+		CHECK(hub.getArmband(1, 1) == NULL);
+		hub.update();
+		CHECK(hub.armbands.size() == 3);
+
+		// events from both hosts in one update() come out in the order they
+		// arrived, not host by host
+		second.simulatePose(0, "fist");
+		ofSleepMillis(20);
+		first.simulatePose(1, "fist");
+		ofSleepMillis(100);
+		hub.update();
+
+		vector<EventLog::Entry> poses = log.get();
+		if (CHECK(poses.size() >= 2)) {
+			CHECK(poses[0].type == "poseStarted" && poses[0].host == 1 && poses[0].id == 0);
+			CHECK(poses[1].type == "poseStarted" && poses[1].host == 0 && poses[1].id == 1);
+		}
+
+		// and the rest of the fists
+		float settle = ofGetElapsedTimef();
+		while (ofGetElapsedTimef() - settle < 1.0f) {
+			update();
+			ofSleepMillis(1);
+		}
+		log.clear();
+
+		// commands go to the armband's own host only
+		unsigned int firstCommands = first.getCommandCount();
+		unsigned int secondCommands = second.getCommandCount();
+		hub.requestSignalStrength(armband);
+		CHECK(tests::waitFor([&]{ return log.get().size() > 0; }, update));
+		CHECK(second.getCommandCount() == secondCommands + 1);
+		CHECK(first.getCommandCount() == firstCommands);
+
+		vector<EventLog::Entry> entries = log.get();
+		CHECK(entries.size() == 1);
+		if (entries.size() == 1) {
+			CHECK(entries[0].type == "rssi");
+			CHECK(entries[0].host == 1 && entries[0].id == 0);
+			CHECK(entries[0].mainThread);
+		}
+
+		removeListeners(hub, log);
+
+	}
+
+	//--------------------------------------------------------------
+	// Roll, pitch & yaw as an orientation listener on the socket thread
+	// sees them, against the armband's quaternion
+	struct EulerCheck {
+
+		EulerCheck() : samples(0), worst(0), socketThread(true) {
+			mainThread = std::this_thread::get_id();
+		}
+
+		void onOrientation(Armband& armband){
+			float x = armband.quat.x(), y = armband.quat.y(), z = armband.quat.z(), w = armband.quat.w();
+			float roll = atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y));
+			float pitch = asin(ofClamp(2 * (w * y - z * x), -1, 1));
+			float yaw = atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z));
+			applyEulerConventions(roll, pitch, yaw, armband.direction, armband.useDegrees);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			worst = MAX(worst, fabsf(armband.roll - roll));
+			worst = MAX(worst, fabsf(armband.pitch - pitch));
+			worst = MAX(worst, fabsf(armband.yaw - yaw));
+			socketThread &= std::this_thread::get_id() != mainThread;
+			samples++;
+		}
+
+		int getSamples(){
+			std::lock_guard<std::mutex> lock(mutex);
+			return samples;
+		}
+
+		std::mutex			mutex;
+		std::thread::id		mainThread;
+		int					samples;
+		float				worst;
+		bool				socketThread;
+
+	};
+
+	//--------------------------------------------------------------
+	void testDirectEuler(){
+
+		MockServer server;
+		server.setPoseRate(0);
+		server.setRssiRate(0);
+		CHECK(server.setup(port));
+
+		EulerCheck check;
+
+		Connection myo;
+		myo.setUseDegrees(true);
+		ofAddListener(myo.orientationEvent, &check, &EulerCheck::onOrientation);
+		myo.connect("localhost", port);
+
+		// no update() at all, that's the point
+		CHECK(tests::waitFor([&]{ return check.getSamples() >= 25; }, []{}));
+		ofRemoveListener(myo.orientationEvent, &check, &EulerCheck::onOrientation);
+
+		std::lock_guard<std::mutex> lock(check.mutex);
+		CHECK(check.socketThread);
+
+		// the polynomial approximations, in degrees
+		CHECK(check.worst < 0.01f);
+
+	}
+
+	//--------------------------------------------------------------
+	// Without an app or a clock of its own, every connection reads the same
+	// steady clock, and samples are stamped with it
+	void testDefaultClock(){
+
+		Connection first, second;
+		uint64_t before = first.getElapsedTimeMicros();
+
+		second.processMessage("[\"event\",{\"type\":\"orientation\",\"timestamp\":\"1\",\"myo\":0,"
+			"\"orientation\":{\"x\":0,\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0,0]}]");
+		second.update();
+
+		uint64_t after = first.getElapsedTimeMicros();
+		CHECK(before <= after && after - before < 1000000);
+
+		Armband* armband = second.findArmband(0);
+		if (CHECK(armband && armband->history)) {
+			ImuSamples samples = armband->history->getLast(1);
+			if (CHECK(samples.size() == 1)) {
+				CHECK(samples.timestamp(0) >= before && samples.timestamp(0) <= after);
+			}
+		}
+
+	}
+
+	//--------------------------------------------------------------
+	// Armbands which don't come back after a reconnect are dropped once the
+	// stale timeout's up, even with nothing else coming in to notice by
+	void testStaleExpiry(){
+
+		MockServer server;
+		server.setNumArmbands(2);
+		server.setOrientationRate(0);
+		server.setPoseRate(0);
+		server.setRssiRate(0);
+		CHECK(server.setup(port));
+
+		EventLog log;
+
+		Connection myo;
+		myo.setStaleTimeout(0.25);
+		myo.setReconnectDelay(0.05, 0.1);
+		ofAddListener(myo.disconnectedEvent, &log, &EventLog::onDisconnected);
+		ofAddListener(myo.rssiReceivedEvent, &log, &EventLog::onRssiReceived);
+		myo.connect("localhost", port, true);
+
+		auto update = [&]{ myo.update(); };
+
+		if (CHECK(tests::waitFor([&]{ return myo.armbands.size() == 2 && log.count("rssi") >= 2; }, update))) {
+
+			// back with only the one armband, and then quiet
+			server.close();
+			CHECK(tests::waitFor([&]{ return !myo.isConnected(); }, update));
+			CHECK(myo.armbands.size() == 2);
+
+			server.setNumArmbands(1);
+			CHECK(server.setup(port));
+			CHECK(tests::waitFor([&]{ return myo.isConnected(); }, update));
+
+			CHECK(tests::waitFor([&]{ return log.count("disconnected") == 1; }, update));
+			CHECK(tests::waitFor([&]{ return myo.armbands.size() == 1; }, update));
+
+			vector<EventLog::Entry> entries = log.get();
+			for (int i = 0; i < entries.size(); i++) {
+				if (entries[i].type == "disconnected") CHECK(entries[i].id == 1);
+			}
+			if (myo.armbands.size() == 1) CHECK(myo.armbands[0]->id == 0);
+		}
+
+		ofRemoveListener(myo.disconnectedEvent, &log, &EventLog::onDisconnected);
+		ofRemoveListener(myo.rssiReceivedEvent, &log, &EventLog::onRssiReceived);
+
+	}
+
+	//--------------------------------------------------------------
+	// OSC messages, as read back off the wire
+	struct OscMessage {
+		string			address;
+		string			types;
+		vector<int>		ints;
+		vector<float>	floats;
+		vector<string>	strings;
+	};
+
+	//--------------------------------------------------------------
+	uint32_t readInt32(const char* data){
+		const unsigned char* bytes = (const unsigned char*)data;
+		return (uint32_t)bytes[0] << 24 | bytes[1] << 16 | bytes[2] << 8 | bytes[3];
+	}
+
+	//--------------------------------------------------------------
+	// OSC strings are null terminated and padded to 4 bytes
+	bool readString(const char* data, int size, int& position, string& value){
+		int length = strnlen(data + position, size - position);
+		if (position + length >= size) return false;
+		value.assign(data + position, length);
+		position += (length + 4) & ~3;
+		return position <= size;
+	}
+
+	//--------------------------------------------------------------
+	bool readMessage(const char* data, int size, OscMessage& message){
+
+		int position = 0;
+		if (!readString(data, size, position, message.address)) return false;
+		if (!readString(data, size, position, message.types) || message.types.empty() || message.types[0] != ',') return false;
+
+		for (int i = 1; i < message.types.size(); i++) {
+			if (message.types[i] == 's') {
+				string value;
+				if (!readString(data, size, position, value)) return false;
+				message.strings.push_back(value);
+				continue;
+			}
+
+			if (position + 4 > size) return false;
+			uint32_t bits = readInt32(data + position);
+			position += 4;
+
+			if (message.types[i] == 'i') {
+				message.ints.push_back((int32_t)bits);
+			} else if (message.types[i] == 'f') {
+				float value;
+				memcpy(&value, &bits, sizeof(value));
+				message.floats.push_back(value);
+			} else {
+				return false;
+			}
+		}
+
+		return position == size;
+
+	}
+
+	//--------------------------------------------------------------
+	// Every message in a bundle, false if it isn't a well formed one
+	bool readBundle(const char* data, int size, vector<OscMessage>& messages){
+
+		if (size < 16 || memcmp(data, "#bundle\0", 8) != 0) return false;
+
+		// time tag 1, immediately
+		if (readInt32(data + 8) != 0 || readInt32(data + 12) != 1) return false;
+
+		int position = 16;
+		while (position < size) {
+			if (position + 4 > size) return false;
+			int length = readInt32(data + position);
+			position += 4;
+
+			OscMessage message;
+			if (length % 4 != 0 || position + length > size || !readMessage(data + position, length, message)) return false;
+			messages.push_back(message);
+			position += length;
+		}
+
+		return true;
+
+	}
+
+	//--------------------------------------------------------------
+	void testOsc(){
+
+		ofxUDPManager receiver;
+		receiver.Create();
+		if (!CHECK(receiver.Bind(oscPort))) return;
+		receiver.SetNonBlocking(true);
+
+		MockServer server;
+		server.setNumArmbands(2);
+		server.setPoseRate(0);
+		server.setRssiRate(0);
+		CHECK(server.setup(port));
+
+		OscBridge osc;
+		CHECK(osc.setup("127.0.0.1", oscPort));
+		osc.setInterval(0);
+
+		Connection myo;
+		myo.setOscBridge(&osc);
+		myo.connect("localhost", port);
+
+		vector<OscMessage> messages;
+		int bundles = 0;
+		bool wellFormed = true;
+		vector<char> buffer(65536);
+
+		auto receive = [&]{
+			myo.update();
+			int size;
+			while ((size = receiver.Receive(&buffer[0], buffer.size())) > 0) {
+				wellFormed &= readBundle(&buffer[0], size, messages);
+				bundles++;
+			}
+		};
+
+		auto seenOrientation = [&](int id){
+			for (int i = 0; i < messages.size(); i++) {
+				if (messages[i].address == "/myo/orientation" && messages[i].ints.size() && messages[i].ints[0] == id) return true;
+			}
+			return false;
+		};
+
+		CHECK(tests::waitFor([&]{ return seenOrientation(0) && seenOrientation(1); }, receive));
+
+		// with the default policy a fist is confirmed once it's been held,
+		// then it's locked and straight back to a confirmed rest
+		server.simulatePose(1, "fist");
+
+		vector<OscMessage> poses;
+		auto collectPoses = [&]{
+			poses.clear();
+			for (int i = 0; i < messages.size(); i++) {
+				if (messages[i].address != "/myo/orientation" && messages[i].ints.size() && messages[i].ints[0] == 1) poses.push_back(messages[i]);
+			}
+			return poses.size() >= 4;
+		};
+
+		CHECK(tests::waitFor([&]{ return collectPoses(); }, receive));
+
+		myo.setOscBridge(NULL);
+
+		CHECK(bundles > 0);
+		CHECK(wellFormed);
+		CHECK(osc.getDroppedCount() == 0);
+
+		for (int i = 0; i < messages.size(); i++) {
+			const OscMessage& message = messages[i];
+			if (message.address != "/myo/orientation") continue;
+
+			// id, roll, pitch, yaw, quat, accel, gyro
+			CHECK(message.types == ",ifffffffffffff");
+			CHECK(message.ints.size() == 1 && message.floats.size() == 13);
+			break;
+		}
+
+		if (CHECK(poses.size() == 4)) {
+			CHECK(poses[0].address == "/myo/pose" && poses[0].types == ",isi");
+			CHECK(poses[0].strings == vector<string>(1, "fist") && poses[0].ints[1] == 0);
+			CHECK(poses[1].address == "/myo/pose" && poses[1].strings == vector<string>(1, "fist") && poses[1].ints[1] == 1);
+			CHECK(poses[2].address == "/myo/unlocked" && poses[2].types == ",ii" && poses[2].ints[1] == 0);
+			CHECK(poses[3].address == "/myo/pose" && poses[3].strings == vector<string>(1, "rest") && poses[3].ints[1] == 1);
+		}
+
+		receiver.Close();
+
+	}
+
+}
+
+//--------------------------------------------------------------
+void tests::testConnection(){
+
+	testEventOrder(false);
+	testEventOrder(true);
+	testDirectEuler();
+	testDefaultClock();
+	testHub();
+	testStaleExpiry();
+	testOsc();
+
+}
@@ -0,0 +1,156 @@
+#include "Tests.h"
+#include "ofxMyoWebSocketsEuler.h"
+
+#include <random>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	//--------------------------------------------------------------
+	// Difference between two angles, the short way round
+	double angleError(double a, double b){
+		double difference = fmod(fabs(a - b), 2 * PI);
+		return MIN(difference, 2 * PI - difference);
+	}
+
+	//--------------------------------------------------------------
+	// The approximations against the exact functions, all the way round
+	void testApproximations(){
+
+		double worstAtan2 = 0, worstAsin = 0;
+
+		for (int i = 0; i < 3600; i++) {
+			double angle = i * PI / 1800;
+			for (double radius = 0.001; radius < 1000; radius *= 10) {
+				float y = radius * sin(angle);
+				float x = radius * cos(angle);
+				worstAtan2 = MAX(worstAtan2, angleError(fastAtan2(y, x), atan2((double)y, (double)x)));
+			}
+		}
+
+		for (int i = -10000; i <= 10000; i++) {
+			float x = i / 10000.0f;
+			worstAsin = MAX(worstAsin, fabs(fastAsin(x) - asin((double)x)));
+		}
+
+		CHECK(worstAtan2 < 2e-6);
+		CHECK(worstAsin < 2e-6);
+
+		// the corners
+		CHECK(fastAtan2(0, 0) == 0);
+		CHECK(fabs(fastAtan2(0, -1) - PI) < 1e-6);
+		CHECK(fabs(fastAtan2(1, 0) - HALF_PI) < 1e-6);
+		CHECK(fabs(fastAtan2(-1, 0) + HALF_PI) < 1e-6);
+
+		// clamped rather than NaN
+		CHECK(fabs(fastAsin(1.5f) - HALF_PI) < 1e-6);
+		CHECK(fabs(fastAsin(-1.5f) + HALF_PI) < 1e-6);
+
+	}
+
+	//--------------------------------------------------------------
+	// Whatever the vector width, every quaternion in a batch (the ones
+	// which fill whole vectors and the ones left over) comes out the same
+	// as converting it on its own, and close to a double precision
+	// conversion
+	void testBatch(){
+
+		std::mt19937 random(5);
+		std::normal_distribution<float> normal;
+
+		// odd lengths and offsets, so there's a tail and nothing's aligned
+		const int count = 1003;
+		vector<float> x(count + 1), y(count + 1), z(count + 1), w(count + 1);
+		vector<float> roll(count + 1), pitch(count + 1), yaw(count + 1);
+
+		for (int i = 1; i <= count; i++) {
+			float q[4] = { normal(random), normal(random), normal(random), normal(random) };
+
+			// now and then straight up or down, where roll & yaw go wild
+			if (i % 50 == 0) { q[0] = q[2] = 0; q[1] = q[3] = 1; }
+
+			float length = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+			x[i] = q[0] / length;
+			y[i] = q[1] / length;
+			z[i] = q[2] / length;
+			w[i] = q[3] / length;
+		}
+
+		quaternionsToEuler(&x[1], &y[1], &z[1], &w[1], count, &roll[1], &pitch[1], &yaw[1]);
+
+		double worstScalar = 0, worstExact = 0, worstPole = 0;
+		bool finite = true;
+
+		for (int i = 1; i <= count; i++) {
+
+			float sx = x[i], sy = y[i], sz = z[i], sw = w[i];
+			float scalarRoll = fastAtan2(2.0f * (sw * sx + sy * sz), 1.0f - 2.0f * (sx * sx + sy * sy));
+			float scalarPitch = fastAsin(2.0f * (sw * sy - sz * sx));
+			float scalarYaw = fastAtan2(2.0f * (sw * sz + sx * sy), 1.0f - 2.0f * (sy * sy + sz * sz));
+
+			worstScalar = MAX(worstScalar, angleError(roll[i], scalarRoll));
+			worstScalar = MAX(worstScalar, fabs(pitch[i] - scalarPitch));
+			worstScalar = MAX(worstScalar, angleError(yaw[i], scalarYaw));
+
+			finite &= !std::isnan(roll[i]) && !std::isnan(pitch[i]) && !std::isnan(yaw[i]);
+
+			// float rounding of the terms alone moves every angle a long way
+			// near straight up or down, where roll & yaw don't mean much
+			double dx = sx, dy = sy, dz = sz, dw = sw;
+			double sinPitch = 2 * (dw * dy - dz * dx);
+			if (fabs(sinPitch) > 0.999) {
+				worstPole = MAX(worstPole, fabs(pitch[i] - asin(MIN(MAX(sinPitch, -1.0), 1.0))));
+				continue;
+			}
+
+			worstExact = MAX(worstExact, fabs(pitch[i] - asin(sinPitch)));
+			worstExact = MAX(worstExact, angleError(roll[i], atan2(2 * (dw * dx + dy * dz), 1 - 2 * (dx * dx + dy * dy))));
+			worstExact = MAX(worstExact, angleError(yaw[i], atan2(2 * (dw * dz + dx * dy), 1 - 2 * (dy * dy + dz * dz))));
+		}
+
+		CHECK(finite);
+		CHECK(worstScalar < 1e-6);
+		CHECK(worstExact < 3e-5);
+		CHECK(worstPole < 1e-3);
+
+		// and through EulerBatch, which is what Connection uses
+		EulerBatch batch;
+		for (int i = 1; i <= 13; i++) batch.add(x[i], y[i], z[i], w[i]);
+		batch.convert();
+
+		bool same = batch.roll.size() == 13;
+		for (int i = 0; i < batch.roll.size(); i++) {
+			same &= batch.roll[i] == roll[i + 1] && batch.pitch[i] == pitch[i + 1] && batch.yaw[i] == yaw[i + 1];
+		}
+		CHECK(same);
+
+		batch.clear();
+		batch.convert();
+		CHECK(batch.roll.empty());
+
+	}
+
+	//--------------------------------------------------------------
+	void testConventions(){
+
+		float roll = HALF_PI, pitch = 0.25f, yaw = -0.5f;
+		applyEulerConventions(roll, pitch, yaw, X_DIRECTION_TOWARD_WRIST, true);
+		CHECK(fabs(roll - 90) < 1e-4 && fabs(pitch + 0.25f * RAD_TO_DEG) < 1e-4 && fabs(yaw + 0.5f * RAD_TO_DEG) < 1e-4);
+
+		roll = 0.5f; pitch = 0.25f; yaw = 0.125f;
+		applyEulerConventions(roll, pitch, yaw, X_DIRECTION_TOWARD_ELBOW, false);
+		CHECK(roll == -0.5f && pitch == 0.25f && yaw == 0.125f);
+
+	}
+
+}
+
+//--------------------------------------------------------------
+void tests::testEuler(){
+
+	testApproximations();
+	testBatch();
+	testConventions();
+
+}
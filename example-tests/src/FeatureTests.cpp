@@ -0,0 +1,168 @@
+#include "Tests.h"
+#include "ofxMyoWebSocketsFeatures.h"
+
+#include <random>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	//--------------------------------------------------------------
+	// Mean and standard deviation of values, the long way
+	void getStats(const vector<double>& values, double& mean, double& deviation){
+		mean = 0;
+		for (int i = 0; i < values.size(); i++) mean += values[i];
+		mean /= MAX(values.size(), 1);
+
+		double m2 = 0;
+		for (int i = 0; i < values.size(); i++) m2 += (values[i] - mean) * (values[i] - mean);
+		deviation = values.size() > 1 ? sqrt(m2 / values.size()) : 0;
+	}
+
+	//--------------------------------------------------------------
+	bool near(double a, double b, double tolerance){
+		return fabs(a - b) <= tolerance * MAX(1.0, fabs(b));
+	}
+
+	//--------------------------------------------------------------
+	// Every feature after every sample, against working it out from the
+	// window from scratch
+	void testEmg(){
+
+		const int window = 40;
+		FeatureExtractor extractor;
+		extractor.setWindows(window, 10);
+
+		std::mt19937 random(3);
+		std::uniform_int_distribution<int> value(-128, 127);
+
+		vector< vector<int> > samples;
+		int wrong = 0;
+
+		for (int n = 0; n < 500; n++) {
+
+			int8_t sample[emgChannels];
+			vector<int> values(emgChannels);
+			for (int i = 0; i < emgChannels; i++) {
+				// quiet stretches too, for the dead band
+				values[i] = (n / 50) % 2 ? value(random) : value(random) / 20;
+				sample[i] = values[i];
+			}
+
+			extractor.addEmg(sample);
+			samples.push_back(values);
+
+			Features features;
+			extractor.getFeatures(features);
+
+			int first = MAX((int)samples.size() - window, 0);
+			if (features.emg.samples != samples.size() - first) wrong++;
+
+			for (int i = 0; i < emgChannels; i++) {
+
+				double squares = 0, abs = 0;
+				int crossings = 0;
+				int lastSign = 0;
+
+				// crossings are counted against the sample before, even if
+				// that's dropped out of the window since
+				for (int j = 0; j < samples.size(); j++) {
+					int x = samples[j][i];
+					if (j >= first) {
+						squares += x * x;
+						abs += fabs(x);
+					}
+					if (std::abs(x) < FeatureExtractor::zeroCrossingThreshold) continue;
+					int sign = x > 0 ? 1 : -1;
+					if (lastSign && sign != lastSign && j >= first) crossings++;
+					lastSign = sign;
+				}
+
+				int count = samples.size() - first;
+				if (!near(features.emg.rms[i], sqrt(squares / count), 1e-5)) wrong++;
+				if (!near(features.emg.meanAbsoluteValue[i], abs / count, 1e-5)) wrong++;
+				if (features.emg.zeroCrossings[i] != crossings) wrong++;
+			}
+		}
+
+		CHECK(wrong == 0);
+
+	}
+
+	//--------------------------------------------------------------
+	void testImu(){
+
+		const int window = 10;
+		FeatureExtractor extractor;
+		extractor.setWindows(40, window);
+
+		std::mt19937 random(4);
+		std::normal_distribution<float> normal;
+
+		vector<double> speeds, jerks;
+		float lastAccel[3];
+		int wrong = 0;
+
+		// long enough for the sliding sums to have drifted, on a large
+		// offset so any drift shows
+		for (int n = 0; n < 100000; n++) {
+
+			float accel[3], gyro[3];
+			for (int i = 0; i < 3; i++) {
+				accel[i] = normal(random);
+				gyro[i] = 1000 + normal(random) * 0.01f;
+			}
+
+			extractor.addImu(accel, gyro);
+
+			speeds.push_back(sqrtf(gyro[0] * gyro[0] + gyro[1] * gyro[1] + gyro[2] * gyro[2]));
+			if (n > 0) {
+				float dx = accel[0] - lastAccel[0], dy = accel[1] - lastAccel[1], dz = accel[2] - lastAccel[2];
+				jerks.push_back(sqrtf(dx * dx + dy * dy + dz * dz) * FeatureExtractor::imuRate);
+			}
+			memcpy(lastAccel, accel, sizeof(lastAccel));
+
+			if (speeds.size() > window) speeds.erase(speeds.begin());
+			if (jerks.size() > window) jerks.erase(jerks.begin());
+
+			if (n % 97 != 0 && n > 20 && n < 99990) continue;
+
+			Features features;
+			extractor.getFeatures(features);
+
+			double mean, deviation;
+			getStats(speeds, mean, deviation);
+			if (features.imu.samples != speeds.size()) wrong++;
+			if (!near(features.imu.angularSpeed, mean, 1e-6)) wrong++;
+			if (fabs(features.imu.angularSpeedDeviation - deviation) > 1e-3 * MAX(deviation, 1e-3)) wrong++;
+
+			// no jerk of 0 for the first sample
+			getStats(jerks, mean, deviation);
+			if (!near(features.imu.jerk, mean, 1e-5)) wrong++;
+			if (!near(features.imu.jerkDeviation, deviation, 1e-4)) wrong++;
+		}
+
+		CHECK(wrong == 0);
+
+		// one sample has no jerk at all
+		extractor.clear();
+		float accel[3] = { 0, 0, 1 };
+		float gyro[3] = { 0, 0, 0 };
+		extractor.addImu(accel, gyro);
+
+		Features features;
+		extractor.getFeatures(features);
+		CHECK(features.imu.samples == 1);
+		CHECK(features.imu.jerk == 0);
+
+	}
+
+}
+
+//--------------------------------------------------------------
+void tests::testFeatures(){
+
+	testEmg();
+	testImu();
+
+}
@@ -0,0 +1,173 @@
+#include "Tests.h"
+#include "ofxMyoWebSocketsGestures.h"
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	//--------------------------------------------------------------
+	// What the hard-coded rules did before there were policies: rest was
+	// confirmed straight away, double tap unlocked as soon as it started,
+	// and anything else was confirmed once held. Thumb to pinky and double
+	// tap then unlocked, anything else locked again.
+	int getOriginalActions(GestureMachine::Trigger trigger, bool unlocked, Pose pose, bool requiresUnlock, bool lockAfterPose){
+
+		bool allowed = unlocked || !requiresUnlock;
+		bool unlockPose = pose == POSE_THUMB_TO_PINKY || pose == POSE_DOUBLE_TAP;
+		int actions = 0;
+
+		if (trigger == GestureMachine::STARTED) {
+			if (pose == POSE_REST) {
+				if (allowed) actions |= GestureMachine::CONFIRM;
+			} else {
+				actions |= GestureMachine::WAIT;
+			}
+
+			if (pose == POSE_DOUBLE_TAP) actions |= GestureMachine::TAP_UNLOCK;
+			return actions;
+		}
+
+		if (allowed) actions |= GestureMachine::CONFIRM;
+		if (pose == POSE_REST) return actions;
+
+		if (unlockPose) actions |= GestureMachine::UNLOCK;
+		else if (lockAfterPose && unlocked) actions |= GestureMachine::RELOCK;
+
+		return actions;
+
+	}
+
+	//--------------------------------------------------------------
+	// The default policy, with the old settings on top, compiles to the
+	// same table as the old rules
+	void testDefaultPolicy(){
+
+		for (int settings = 0; settings < 4; settings++) {
+
+			GesturePolicy policy;
+			policy.requiresUnlock = settings & 1;
+			policy.lockAfterPose = settings & 2;
+
+			GestureMachine machine(policy);
+
+			for (int trigger = 0; trigger < 2; trigger++) {
+				for (int unlocked = 0; unlocked < 2; unlocked++) {
+					for (int p = 0; p < numPoses; p++) {
+						GestureMachine::Trigger t = (GestureMachine::Trigger)trigger;
+						Pose pose = (Pose)p;
+
+						int actions = machine.getActions(t, unlocked, pose);
+						int expected = getOriginalActions(t, unlocked, pose, policy.requiresUnlock, policy.lockAfterPose);
+
+						if (!CHECK(actions == expected)) {
+							ofLogError("tests") << "requiresUnlock " << policy.requiresUnlock << " lockAfterPose " << policy.lockAfterPose
+								<< (t == GestureMachine::STARTED ? " started " : " held ") << toString(pose) << " unlocked " << unlocked
+								<< ": " << actions << ", expected " << expected;
+						}
+					}
+				}
+			}
+		}
+
+	}
+
+	//--------------------------------------------------------------
+	void testRequiresUnlock(){
+
+		GesturePolicy policy;
+		policy.requiresUnlock = true;
+
+		GestureMachine machine(policy);
+		const GestureMachine::Trigger started = GestureMachine::STARTED;
+		const GestureMachine::Trigger held = GestureMachine::HELD;
+
+		// nothing counts while locked, apart from unlocking
+		CHECK(machine.getActions(started, false, POSE_REST) == 0);
+		CHECK(machine.getActions(held, false, POSE_REST) == 0);
+		CHECK(machine.getActions(started, false, POSE_FIST) == GestureMachine::WAIT);
+		CHECK(machine.getActions(held, false, POSE_FIST) == 0);
+		CHECK(machine.getActions(held, false, POSE_THUMB_TO_PINKY) == GestureMachine::UNLOCK);
+		CHECK(machine.getActions(started, false, POSE_DOUBLE_TAP) == (GestureMachine::WAIT | GestureMachine::TAP_UNLOCK));
+
+		// once unlocked a pose counts, then locks again
+		CHECK(machine.getActions(started, true, POSE_REST) == GestureMachine::CONFIRM);
+		CHECK(machine.getActions(started, true, POSE_FIST) == GestureMachine::WAIT);
+		CHECK(machine.getActions(held, true, POSE_FIST) == (GestureMachine::CONFIRM | GestureMachine::RELOCK));
+		CHECK(machine.getActions(held, true, POSE_THUMB_TO_PINKY) == (GestureMachine::CONFIRM | GestureMachine::UNLOCK));
+
+		// or stays unlocked until the timeout
+		policy.lockAfterPose = false;
+		machine.compile(policy);
+		CHECK(machine.getActions(held, true, POSE_FIST) == GestureMachine::CONFIRM);
+		CHECK(machine.getActions(held, false, POSE_FIST) == 0);
+
+		// a pose of one's own to unlock with, and one which counts right away
+		policy.unlockPoses.assign(1, POSE_WAVE_OUT);
+		policy.tapUnlockPoses.clear();
+		policy.immediatePoses.push_back(POSE_FINGERS_SPREAD);
+		machine.compile(policy);
+		CHECK(machine.getActions(held, false, POSE_WAVE_OUT) == GestureMachine::UNLOCK);
+		CHECK(machine.getActions(held, false, POSE_THUMB_TO_PINKY) == 0);
+		CHECK(machine.getActions(started, false, POSE_DOUBLE_TAP) == GestureMachine::WAIT);
+		CHECK(machine.getActions(started, false, POSE_FINGERS_SPREAD) == 0);
+		CHECK(machine.getActions(started, true, POSE_FINGERS_SPREAD) == GestureMachine::CONFIRM);
+		CHECK(machine.getActions(held, true, POSE_FINGERS_SPREAD) == GestureMachine::CONFIRM);
+
+	}
+
+	//--------------------------------------------------------------
+	int match(const GestureMachine& machine, const vector<Pose>& poses, const vector<float>& times){
+
+		PoseHistory history;
+		for (int i = 0; i < poses.size(); i++) {
+			history.push(poses[i], 1000000 + times[i] * 1000000);
+		}
+
+		return machine.matchSequence(history);
+
+	}
+
+	//--------------------------------------------------------------
+	void testSequences(){
+
+		GesturePolicy policy;
+		int fistWaveIn = policy.addSequence("fist, wave in", { POSE_FIST, POSE_WAVE_IN }, 0.5);
+		int fistRestFist = policy.addSequence("fist, rest, fist", { POSE_FIST, POSE_REST, POSE_FIST }, 1.0);
+
+		GestureMachine machine(policy);
+		CHECK(fistWaveIn == 0);
+		CHECK(fistRestFist == 1);
+
+		// rest in between is skipped
+		CHECK(match(machine, { POSE_FIST, POSE_WAVE_IN }, { 0, 0.3 }) == fistWaveIn);
+		CHECK(match(machine, { POSE_FIST, POSE_REST, POSE_WAVE_IN }, { 0, 0.2, 0.4 }) == fistWaveIn);
+		CHECK(match(machine, { POSE_WAVE_OUT, POSE_FIST, POSE_REST, POSE_WAVE_IN }, { 0, 0.1, 0.2, 0.5 }) == fistWaveIn);
+
+		// too slow, the wrong way round, something else in between, or not
+		// finished yet
+		CHECK(match(machine, { POSE_FIST, POSE_WAVE_IN }, { 0, 0.6 }) == -1);
+		CHECK(match(machine, { POSE_FIST, POSE_REST, POSE_WAVE_IN }, { 0, 0.3, 0.6 }) == -1);
+		CHECK(match(machine, { POSE_WAVE_IN, POSE_FIST }, { 0, 0.3 }) == -1);
+		CHECK(match(machine, { POSE_FIST, POSE_WAVE_OUT, POSE_WAVE_IN }, { 0, 0.1, 0.2 }) == -1);
+		CHECK(match(machine, { POSE_FIST }, { 0 }) == -1);
+		CHECK(match(machine, { POSE_WAVE_IN }, { 0 }) == -1);
+
+		// unless the sequence has rest in it
+		CHECK(match(machine, { POSE_FIST, POSE_REST, POSE_FIST }, { 0, 0.2, 0.4 }) == fistRestFist);
+		CHECK(match(machine, { POSE_FIST, POSE_FIST }, { 0, 0.2 }) == -1);
+
+		// the latest pose has to finish it off
+		CHECK(match(machine, { POSE_FIST, POSE_WAVE_IN, POSE_REST }, { 0, 0.2, 0.3 }) == -1);
+
+	}
+
+}
+
+//--------------------------------------------------------------
+void tests::testGestures(){
+
+	testDefaultPolicy();
+	testRequiresUnlock();
+	testSequences();
+
+}
@@ -0,0 +1,266 @@
+#include "Tests.h"
+#include "ofxMyoWebSockets.h"
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	//--------------------------------------------------------------
+	string makeOrientation(int myo){
+		return "[\"event\",{\"type\":\"orientation\",\"timestamp\":\"1\",\"myo\":" + ofToString(myo) + ","
+			"\"orientation\":{\"x\":0,\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0,0]}]";
+	}
+
+	//--------------------------------------------------------------
+	// Sizes only change before anything's come in, since the armbands hold
+	// on to their histories from then on
+	void testSizes(){
+
+		Connection myo;
+		myo.setImuHistorySize(64);
+		myo.setEmgHistorySize(128);
+
+		myo.processMessage(makeOrientation(0));
+		myo.update();
+
+		Armband* armband = myo.findArmband(0);
+		if (!CHECK(armband && armband->history && armband->emgHistory)) return;
+
+		CHECK(armband->history->getCapacity() == 64);
+		CHECK(armband->emgHistory->getCapacity() == 128);
+
+		ImuHistory* history = armband->history;
+		EmgHistory* emgHistory = armband->emgHistory;
+
+		// too late, every armband keeps what it had
+		myo.setImuHistorySize(8);
+		myo.setEmgHistorySize(8);
+		myo.setMaxArmbands(2);
+
+		myo.processMessage(makeOrientation(1));
+		myo.update();
+
+		CHECK(armband->history == history && history->getCapacity() == 64);
+		CHECK(armband->emgHistory == emgHistory && emgHistory->getCapacity() == 128);
+
+		Armband* second = myo.findArmband(1);
+		if (CHECK(second && second->history)) {
+			CHECK(second->history != history);
+			CHECK(second->history->getCapacity() == 64);
+		}
+
+		CHECK(myo.armbands.size() == 2);
+
+	}
+
+	//--------------------------------------------------------------
+	// Window arithmetic across the wrap of the sequence numbers themselves
+	void testRingWindow(){
+
+		RingWindow window(7, 0xfffffffc, 4);
+		CHECK(window.size() == 8);
+		CHECK(window.end() == 4);
+
+		int offsets[2], lengths[2];
+		CHECK(window.getRuns(offsets, lengths) == 2);
+		CHECK(offsets[0] == 4 && lengths[0] == 4 && offsets[1] == 0 && lengths[1] == 4);
+
+		RingWindow last = window.getLast(3);
+		CHECK(last.first == 1 && last.size() == 3);
+		CHECK(window.getLast(100).size() == 8);
+		CHECK(window.getLast(-1).empty());
+
+		RingWindow from = window.getFrom(0xfffffffe);
+		CHECK(from.first == 0xfffffffe && from.size() == 6);
+		CHECK(window.getFrom(0xfffffff0).first == 0xfffffffc);
+
+		// nothing written there yet
+		CHECK(window.getFrom(4).empty() && window.getFrom(4).end() == 4);
+		CHECK(window.getFrom(10).empty() && window.getFrom(10).end() == 4);
+
+		// timestamps are the sequence numbers, mod 8
+		RingWindow since = window.getSince(2, [](int slot){ return (uint64_t)((slot + 4) % 8); });
+		CHECK(since.first == 0xffffffff && since.size() == 5);
+
+	}
+
+	//--------------------------------------------------------------
+	// Pushes count IMU samples timestamped 0, 1, 2, ...
+	void pushImu(ImuHistory& history, int count){
+		float accel[3] = { 0, 0, 1 };
+		float gyro[3] = { 0, 0, 0 };
+		float quat[4] = { 0, 0, 0, 1 };
+		for (int i = 0; i < count; i++) {
+			accel[0] = history.getSampleCount();
+			history.push(history.getSampleCount(), accel, gyro, quat);
+		}
+	}
+
+	//--------------------------------------------------------------
+	void testImuWindows(){
+
+		ImuHistory history;
+		history.setCapacity(16);
+		pushImu(history, 40);
+
+		// 12 readable, wrapping around the end of the arrays
+		ImuSamples all = history.getAll();
+		if (!CHECK(all.size() == 12)) return;
+		CHECK(all.first == 28 && all.end() == 40);
+
+		bool ordered = true;
+		for (int i = 0; i < all.size(); i++) {
+			ordered &= all.timestamp(i) == 28 + i && all.accel(i, 0) == 28 + i;
+		}
+		CHECK(ordered);
+
+		int offsets[2], lengths[2];
+		CHECK(all.getRuns(offsets, lengths) == 2);
+		CHECK(offsets[0] == 12 && lengths[0] == 4 && offsets[1] == 0 && lengths[1] == 8);
+
+		CHECK(history.getLast(5).first == 35);
+		CHECK(history.getSince(30).first == 31 && history.getSince(30).size() == 9);
+		CHECK(history.getSince(100).empty());
+		CHECK(history.getFrom(36).size() == 4);
+		CHECK(history.getFrom(3).first == 28);
+		CHECK(history.getFrom(40).empty());
+		CHECK(history.getFrom(45).empty());
+
+		// the headroom runs out after another quarter of the buffer
+		CHECK(all.isValid());
+		pushImu(history, 3);
+		CHECK(all.isValid());
+		pushImu(history, 1);
+		CHECK(!all.isValid());
+
+		history.clear();
+		CHECK(history.getAll().empty());
+		pushImu(history, 2);
+		CHECK(history.getAll().size() == 2 && history.getAll().first == 44);
+
+	}
+
+	//--------------------------------------------------------------
+	void testEmgWindows(){
+
+		EmgHistory history;
+		history.setCapacity(16);
+
+		int8_t sample[emgChannels] = {};
+		for (int i = 0; i < 40; i++) {
+			sample[0] = i;
+			history.push(i, sample);
+		}
+
+		EmgSamples all = history.getAll();
+		if (!CHECK(all.size() == 12)) return;
+		CHECK(all.first == 28);
+
+		int8_t copy[12 * emgChannels];
+		uint64_t timestamps[12];
+		CHECK(all.copyTo(copy, timestamps) == 12);
+
+		bool ordered = true;
+		for (int i = 0; i < 12; i++) {
+			ordered &= copy[i * emgChannels] == 28 + i && timestamps[i] == 28 + i && all.value(i, 0) == 28 + i;
+		}
+		CHECK(ordered);
+
+		CHECK(history.getLast(3).first == 37);
+		CHECK(history.getSince(35).size() == 4);
+		CHECK(history.getFrom(38).size() == 2);
+		CHECK(history.getFrom(0).first == 28);
+		CHECK(history.getFrom(41).empty() && history.getFrom(41).end() == 40);
+
+		// overwritten underneath
+		for (int i = 0; i < 4; i++) history.push(40 + i, sample);
+		CHECK(all.copyTo(copy) == 0);
+
+	}
+
+#ifndef _WIN32
+	//--------------------------------------------------------------
+	// Publisher to reader through a real segment
+	void testSharedMemory(){
+
+		string name = "/ofxMyoWebSocketsTests";
+
+		SharedMemoryPublisher publisher;
+		if (!CHECK(publisher.open(name, 4, 16))) {
+			ofLogError("tests") << publisher.getError();
+			return;
+		}
+
+		SharedArmbandState state = SharedArmbandState();
+		state.id = 7;
+		state.pose = 2;
+		state.quat[3] = 1;
+		publisher.setArmband(1, state);
+
+		float accel[3] = { 0, 0, 1 };
+		float gyro[3] = { 0, 0, 0 };
+		float quat[4] = { 0, 0, 0, 1 };
+		for (int i = 0; i < 40; i++) {
+			accel[0] = i;
+			publisher.addSample(1, i, accel, gyro, quat);
+		}
+
+		SharedMemoryReader reader;
+		if (!CHECK(reader.open(name))) return;
+		CHECK(reader.isPublishing());
+		CHECK(reader.getMaxArmbands() == 4 && reader.getHistorySize() == 16);
+
+		CHECK(reader.find(7) == 1);
+		CHECK(reader.find(7, 1) == -1);
+		CHECK(reader.find(8) == -1);
+
+		SharedArmbandState read;
+		CHECK(!reader.read(0, read));
+		if (CHECK(reader.read(1, read))) {
+			CHECK(read.active && read.id == 7 && read.pose == 2 && read.quat[3] == 1);
+		}
+
+		SharedSamples all = reader.getAll(1);
+		if (CHECK(all.size() == 12)) {
+			bool ordered = true;
+			for (int i = 0; i < all.size(); i++) {
+				ordered &= all.timestamp(i) == 28 + i && all.sample(i).accel[0] == 28 + i;
+			}
+			CHECK(ordered);
+			CHECK(all.isValid());
+		}
+
+		CHECK(reader.getLast(1, 2).first == 38);
+		CHECK(reader.getFrom(1, 30).size() == 10);
+		CHECK(reader.getFrom(1, 50).empty());
+		CHECK(reader.getAll(2).empty());
+
+		// a new armband in the slot doesn't see the old one's samples
+		publisher.removeArmband(1);
+		CHECK(reader.find(7) == -1);
+		state.id = 9;
+		publisher.setArmband(1, state);
+		CHECK(reader.getAll(1).empty());
+		publisher.addSample(1, 40, accel, gyro, quat);
+		CHECK(reader.getAll(1).size() == 1 && reader.getAll(1).first == 40);
+
+		publisher.close();
+		CHECK(!reader.isPublishing());
+
+	}
+#endif
+
+}
+
+//--------------------------------------------------------------
+void tests::testHistories(){
+
+	testSizes();
+	testRingWindow();
+	testImuWindows();
+	testEmgWindows();
+#ifndef _WIN32
+	testSharedMemory();
+#endif
+
+}
@@ -0,0 +1,214 @@
+#include "Tests.h"
+#include "ofxJSON.h"
+#include "ofxMyoWebSocketsParser.h"
+
+#include <random>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	//--------------------------------------------------------------
+	bool near(float a, float b){
+		return fabs(a - b) <= 1e-6f * MAX(1.0f, fabs(b));
+	}
+
+	//--------------------------------------------------------------
+	// What the ofxJSON path in Connection makes of the same message
+	bool parseOrientationJson(const string& message, OrientationFrame& frame){
+
+		ofxJSONElement json;
+		if (!json.parse(message)) return false;
+
+		ofxJSONElement data = json[1];
+		if (data["type"].asString() != "orientation") return false;
+
+		frame.myo = data["myo"].asInt();
+		frame.timestamp = data["timestamp"].isString() ? parseTimestamp(data["timestamp"].asString().data(), data["timestamp"].asString().size()) : 0;
+		for (int i = 0; i < 3; i++) {
+			frame.accel[i] = data["accelerometer"][i].asFloat();
+			frame.gyro[i] = data["gyroscope"][i].asFloat();
+		}
+		frame.quat[0] = data["orientation"]["x"].asFloat();
+		frame.quat[1] = data["orientation"]["y"].asFloat();
+		frame.quat[2] = data["orientation"]["z"].asFloat();
+		frame.quat[3] = data["orientation"]["w"].asFloat();
+		return true;
+
+	}
+
+	//--------------------------------------------------------------
+	bool parseEmgJson(const string& message, EmgFrame& frame){
+
+		ofxJSONElement json;
+		if (!json.parse(message)) return false;
+
+		ofxJSONElement data = json[1];
+		if (data["type"].asString() != "emg") return false;
+
+		frame.myo = data["myo"].asInt();
+		frame.timestamp = data["timestamp"].isString() ? parseTimestamp(data["timestamp"].asString().data(), data["timestamp"].asString().size()) : 0;
+		for (int i = 0; i < 8; i++) frame.emg[i] = ofClamp(data["emg"][i].asInt(), -128, 127);
+		return true;
+
+	}
+
+	//--------------------------------------------------------------
+	bool same(const OrientationFrame& a, const OrientationFrame& b){
+		bool equal = a.myo == b.myo && a.timestamp == b.timestamp;
+		for (int i = 0; i < 3; i++) equal &= near(a.accel[i], b.accel[i]) && near(a.gyro[i], b.gyro[i]);
+		for (int i = 0; i < 4; i++) equal &= near(a.quat[i], b.quat[i]);
+		return equal;
+	}
+
+	//--------------------------------------------------------------
+	// Numbers written all the ways JSON allows, which both paths have to
+	// agree on
+	string formatNumber(double value, std::mt19937& random){
+		char buffer[64];
+		switch (random() % 4) {
+			case 0: snprintf(buffer, sizeof(buffer), "%.9g", value); break;
+			case 1: snprintf(buffer, sizeof(buffer), "%.6f", value); break;
+			case 2: snprintf(buffer, sizeof(buffer), "%.7e", value); break;
+			default: snprintf(buffer, sizeof(buffer), "%.17g", value); break;
+		}
+		return buffer;
+	}
+
+	//--------------------------------------------------------------
+	void testOrientation(){
+
+		std::mt19937 random(7);
+		std::uniform_real_distribution<double> unit(-1, 1);
+		std::uniform_real_distribution<double> gyro(-2000, 2000);
+
+		int accepted = 0, wrong = 0;
+
+		for (int n = 0; n < 500; n++) {
+
+			string space = n % 3 == 0 ? " " : n % 3 == 1 ? "\n\t" : "";
+			auto field = [&](string key, string value){ return space + "\"" + key + "\"" + space + ":" + space + value; };
+			auto array = [&](double a, double b, double c){
+				return "[" + formatNumber(a, random) + "," + space + formatNumber(b, random) + "," + formatNumber(c, random) + "]";
+			};
+
+			vector<string> fields;
+			fields.push_back(field("type", "\"orientation\""));
+			fields.push_back(field("timestamp", "\"" + ofToString(1000000 + n * 20000) + "\""));
+			fields.push_back(field("myo", ofToString(n % 4)));
+			fields.push_back(field("orientation", "{\"x\":" + formatNumber(unit(random), random) + ",\"y\":" + formatNumber(unit(random), random) +
+				"," + space + "\"z\":" + formatNumber(unit(random), random) + ",\"w\":" + formatNumber(unit(random), random) + "}"));
+			fields.push_back(field("accelerometer", array(unit(random) * 4, unit(random) * 4, unit(random) * 4)));
+			fields.push_back(field("gyroscope", array(gyro(random), gyro(random), gyro(random))));
+
+			// fields Myo Connect adds now and then, in any order
+			if (n % 5 == 0) fields.push_back(field("warmup_state", "\"warm\""));
+			if (n % 7 == 0) fields.push_back(field("extra", "{\"nested\":[1,{\"a\":\"}]\"}],\"b\":null}"));
+			std::shuffle(fields.begin(), fields.end(), random);
+
+			string message = "[\"event\"," + space + "{";
+			for (int i = 0; i < fields.size(); i++) message += (i ? "," : "") + fields[i];
+			message += space + "}]";
+
+			OrientationFrame fast, json;
+			if (!parseOrientation(message.data(), message.size(), fast)) continue;
+			accepted++;
+			if (!parseOrientationJson(message, json) || !same(fast, json)) {
+				wrong++;
+				ofLogError("tests") << message;
+			}
+
+		}
+
+		CHECK(accepted == 500);
+		CHECK(wrong == 0);
+
+		// left to the ofxJSON path
+		const char* rejected[] = {
+			"[\"event\",{\"type\":\"pose\",\"myo\":0,\"pose\":\"fist\"}]",
+			"[\"event\",{\"type\":\"orientation\",\"myo\":0,\"orientation\":{\"x\":0,\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1]}]",
+			"[\"event\",{\"type\":\"orientation\",\"myo\":0,\"orientation\":{\"x\":0,\"y\":0,\"z\":0},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0,0]}]",
+			"[\"event\",{\"type\":\"orientation\",\"myo\":0,\"orientation\":{\"x\":0,\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0]}]",
+			"[\"event\",{\"type\":\"orientation\",\"myo\":0,\"orientation\":{\"x\":1e40,\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0,0]}]",
+			"[\"event\",{\"type\":\"orientation\",\"na\\u006de\":\"x\",\"myo\":0,\"orientation\":{\"x\":0,\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0,0]}]",
+			"[\"event\",{\"type\":\"orientation\",\"myo\":0,\"orientation\":{\"x\":0,\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0,0]",
+			"[\"event\",{\"type\":\"orientation\",\"myo\":0,\"orientation\":{\"x\":0,\"y\":0,\"z\":0,\"w\":1},\"accelerometer\":[0,0,1],\"gyroscope\":[0,0,0]}",
+			"[\"command\",{\"command\":\"vibrate\",\"myo\":0,\"type\":\"short\"}]",
+			""
+		};
+
+		bool anyAccepted = false;
+		for (int i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++) {
+			OrientationFrame frame;
+			anyAccepted |= parseOrientation(rejected[i], strlen(rejected[i]), frame);
+		}
+		CHECK(!anyAccepted);
+
+	}
+
+	//--------------------------------------------------------------
+	void testEmg(){
+
+		std::mt19937 random(11);
+		std::uniform_int_distribution<int> value(-128, 127);
+
+		int wrong = 0;
+
+		for (int n = 0; n < 200; n++) {
+
+			string message = "[\"event\",{\"type\":\"emg\",\"timestamp\":\"" + ofToString(2000000 + n * 5000) + "\",\"myo\":" + ofToString(n % 3) + ",\"emg\":[";
+			for (int i = 0; i < 8; i++) message += (i ? (n % 2 ? ", " : ",") : "") + ofToString(value(random));
+			message += "]}]";
+
+			EmgFrame fast, json;
+			if (!parseEmg(message.data(), message.size(), fast) || !parseEmgJson(message, json)) {
+				wrong++;
+				continue;
+			}
+
+			bool equal = fast.myo == json.myo && fast.timestamp == json.timestamp;
+			for (int i = 0; i < 8; i++) equal &= fast.emg[i] == json.emg[i];
+			if (!equal) wrong++;
+
+		}
+
+		CHECK(wrong == 0);
+
+		// fractions, out of range, too few
+		const char* rejected[] = {
+			"[\"event\",{\"type\":\"emg\",\"myo\":0,\"emg\":[1.5,0,0,0,0,0,0,0]}]",
+			"[\"event\",{\"type\":\"emg\",\"myo\":0,\"emg\":[1e2,0,0,0,0,0,0,0]}]",
+			"[\"event\",{\"type\":\"emg\",\"myo\":0,\"emg\":[200,0,0,0,0,0,0,0]}]",
+			"[\"event\",{\"type\":\"emg\",\"myo\":0,\"emg\":[0,0,0,0,0,0,0]}]",
+			"[\"event\",{\"type\":\"orientation\",\"myo\":0,\"emg\":[0,0,0,0,0,0,0,0]}]"
+		};
+
+		bool anyAccepted = false;
+		for (int i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++) {
+			EmgFrame frame;
+			anyAccepted |= parseEmg(rejected[i], strlen(rejected[i]), frame);
+		}
+		CHECK(!anyAccepted);
+
+	}
+
+	//--------------------------------------------------------------
+	void testTimestamp(){
+
+		CHECK(parseTimestamp("1445289316123456", 16) == 1445289316123456ULL);
+		CHECK(parseTimestamp("", 0) == 0);
+		CHECK(parseTimestamp("12a4", 4) == 0);
+		CHECK(parseTimestamp("-5", 2) == 0);
+
+	}
+
+}
+
+//--------------------------------------------------------------
+void tests::testParser(){
+
+	testOrientation();
+	testEmg();
+	testTimestamp();
+
+}
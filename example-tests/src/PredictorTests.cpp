@@ -0,0 +1,178 @@
+#include "Tests.h"
+#include "ofxMyoWebSocketsPredictor.h"
+
+#include <random>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+	//--------------------------------------------------------------
+	// Turned angle radians about z
+	void aboutZ(double angle, float quat[4]){
+		quat[0] = quat[1] = 0;
+		quat[2] = sin(angle / 2);
+		quat[3] = cos(angle / 2);
+	}
+
+	//--------------------------------------------------------------
+	// Radians between two orientations
+	double angleBetween(const float a[4], const float b[4]){
+		double dot = fabs(a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+		return 2 * acos(MIN(dot, 1.0));
+	}
+
+	//--------------------------------------------------------------
+	// Turning steadily, the smoothed orientation keeps up, and predictions
+	// land where the armband will be
+	void testSteadyRotation(){
+
+		OrientationPredictor predictor;
+
+		// nothing to go on yet
+		float quat[4];
+		predictor.getMotion().predict(1000000, quat);
+		CHECK(!predictor.getMotion().valid && quat[3] == 1);
+
+		const double speed = 90 * DEG_TO_RAD;
+		const float gyro[3] = { 0, 0, 90 };
+		const uint64_t start = 5000000;
+
+		for (int i = 0; i < 100; i++) {
+			uint64_t time = start + i * 20000;
+			aboutZ(speed * (time - start) / 1000000.0, quat);
+			predictor.add(time, time, quat, gyro);
+		}
+
+		const Motion& motion = predictor.getMotion();
+		CHECK(motion.valid);
+		CHECK(motion.time == start + 99 * 20000);
+		CHECK(fabs(motion.gyro[2] - speed) < 1e-4);
+
+		float expected[4];
+		aboutZ(speed * 99 * 0.02, expected);
+		CHECK(angleBetween(motion.quat, expected) < 0.2 * DEG_TO_RAD);
+
+		// 50ms ahead
+		float predicted[4];
+		motion.predict(motion.time + 50000, predicted);
+		aboutZ(speed * (99 * 0.02 + 0.05), expected);
+		CHECK(angleBetween(predicted, expected) < 0.2 * DEG_TO_RAD);
+
+		// and no further than maxPrediction, either way
+		float capped[4], limit[4];
+		motion.predict(motion.time + 1000000, capped);
+		motion.predict(motion.time + 100000, limit);
+		CHECK(angleBetween(capped, limit) < 1e-5);
+
+		motion.predict(motion.time - 1000000, capped);
+		motion.predict(motion.time - 100000, limit);
+		CHECK(angleBetween(capped, limit) < 1e-5);
+
+		predictor.setMaxPrediction(0);
+		predictor.getMotion().predict(motion.time + 50000, predicted);
+		CHECK(angleBetween(predicted, motion.quat) < 1e-5);
+
+	}
+
+	//--------------------------------------------------------------
+	// Holding still, noise is smoothed out, unless smoothing is off
+	void testSmoothing(){
+
+		std::mt19937 random(9);
+		std::normal_distribution<double> noise(0, 0.5 * DEG_TO_RAD);
+
+		const float still[4] = { 0, 0, 0, 1 };
+		const float gyro[3] = { 0, 0, 0 };
+
+		OrientationPredictor smoothed, raw;
+		raw.setFilter(0, 0);
+
+		double smoothedError = 0, rawError = 0;
+		bool exact = true;
+
+		for (int i = 0; i < 500; i++) {
+			uint64_t time = 1000000 + i * 20000;
+			float quat[4];
+			aboutZ(noise(random), quat);
+
+			smoothed.add(time, time, quat, gyro);
+			raw.add(time, time, quat, gyro);
+
+			exact &= angleBetween(raw.getMotion().quat, quat) < 1e-6;
+			if (i < 100) continue;
+			smoothedError += angleBetween(smoothed.getMotion().quat, still);
+			rawError += angleBetween(raw.getMotion().quat, still);
+		}
+
+		CHECK(exact);
+		CHECK(smoothedError < rawError * 0.5);
+
+		// starts over from the next sample
+		float turned[4];
+		aboutZ(HALF_PI, turned);
+		smoothed.clear();
+		CHECK(!smoothed.getMotion().valid);
+		smoothed.add(20000000, 20000000, turned, gyro);
+		CHECK(angleBetween(smoothed.getMotion().quat, turned) < 1e-6);
+
+	}
+
+	//--------------------------------------------------------------
+	// Samples are timed by Myo Connect's clock, moved onto ours by the
+	// smallest delay seen, so jitter in when they arrive doesn't matter
+	void testSampleTimes(){
+
+		std::mt19937 random(13);
+		std::uniform_int_distribution<int> jitter(0, 20000);
+
+		OrientationPredictor predictor;
+		const float quat[4] = { 0, 0, 0, 1 };
+		const float gyro[3] = { 0, 0, 0 };
+
+		const uint64_t device = 7000000000ULL;
+		const uint64_t local = 3000000;
+		int64_t smallest = 1000000;
+		bool steady = true;
+		uint64_t previous = 0;
+
+		for (int i = 0; i < 200; i++) {
+			int delay = 5000 + jitter(random);
+			uint64_t deviceTime = device + i * 20000;
+			predictor.add(deviceTime, local + i * 20000 + delay, quat, gyro);
+
+			uint64_t time = predictor.getMotion().time;
+
+			// between the shortest delay so far and when it arrived, and at
+			// most 20ms plus the creep after the one before
+			smallest = MIN(smallest, delay);
+			steady &= time >= local + i * 20000 + smallest && time <= local + i * 20000 + delay;
+			if (i > 0) steady &= (int64_t)(time - previous) <= 20000 + 200;
+			previous = time;
+		}
+
+		CHECK(steady);
+
+		// without a timestamp, it's when it arrived
+		predictor.add(0, 50000000, quat, gyro);
+		CHECK(predictor.getMotion().time == 50000000);
+
+		// and when Myo Connect's clock goes back, e.g. it restarted, the
+		// offset starts over
+		predictor.add(1000, 60000000, quat, gyro);
+		CHECK(predictor.getMotion().time == 60000000);
+		predictor.add(21000, 60030000, quat, gyro);
+		CHECK(predictor.getMotion().time == 60020000 + 200);
+
+	}
+
+}
+
+//--------------------------------------------------------------
+void tests::testPredictor(){
+
+	testSteadyRotation();
+	testSmoothing();
+	testSampleTimes();
+
+}
@@ -0,0 +1,59 @@
+#include "Tests.h"
+
+namespace {
+
+	int checks = 0;
+	int failures = 0;
+
+}
+
+//--------------------------------------------------------------
+bool tests::check(bool passed, const char* condition, const char* file, int line){
+
+	checks++;
+
+	if (!passed) {
+		failures++;
+		ofLogError("tests") << ofFilePath::getFileName(file) << ":" << line << ": failed: " << condition;
+	}
+
+	return passed;
+
+}
+
+//--------------------------------------------------------------
+int tests::getNumChecks(){
+	return checks;
+}
+
+//--------------------------------------------------------------
+int tests::getNumFailures(){
+	return failures;
+}
+
+//--------------------------------------------------------------
+void tests::run(string name, void (*test)()){
+
+	int checksBefore = checks;
+	int failuresBefore = failures;
+
+	test();
+
+	ofLogNotice("tests") << name << ": " << checks - checksBefore << " checks, " << failures - failuresBefore << " failed";
+
+}
+
+//--------------------------------------------------------------
+bool tests::waitFor(std::function<bool()> done, std::function<void()> update, float timeout){
+
+	float start = ofGetElapsedTimef();
+
+	while (!done()) {
+		if (ofGetElapsedTimef() - start > timeout) return false;
+		update();
+		ofSleepMillis(1);
+	}
+
+	return true;
+
+}
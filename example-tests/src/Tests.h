@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ofMain.h"
+
+// Counts the check, and logs it with where it happened if it failed.
+// Evaluates to whether it passed.
+#define CHECK(condition) tests::check((condition), #condition, __FILE__, __LINE__)
+
+namespace tests {
+
+	bool check(bool passed, const char* condition, const char* file, int line);
+
+	int getNumChecks();
+	int getNumFailures();
+
+	// Runs one group of tests, logging how it went
+	void run(string name, void (*test)());
+
+	// Calls update() until done() or timeout seconds have passed. Returns
+	// done(), for CHECK.
+	bool waitFor(std::function<bool()> done, std::function<void()> update, float timeout = 5);
+
+	// MockServer to Connection over loopback
+	void testConnection();
+
+	// Gesture policies compiled to tables, and pose sequences
+	void testGestures();
+
+	// SampleEncoder to SampleDecoder
+	void testCodec();
+
+	// Fast orientation & EMG parsing against ofxJSON
+	void testParser();
+
+	// Serializing, deduplicating and flushing outgoing commands
+	void testCommands();
+
+	// Quaternions to Euler angles, vectorized and not
+	void testEuler();
+
+	// IMU and EMG sample histories
+	void testHistories();
+
+	// Sliding window features against the same worked out from scratch
+	void testFeatures();
+
+	// Orientation smoothing, prediction and sample timing
+	void testPredictor();
+
+	// Triple buffer, slot pool, and handing armbands and settings between
+	// threads
+	void testBuffers();
+
+}
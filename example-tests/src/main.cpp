@@ -0,0 +1,15 @@
+#include "ofMain.h"
+#include "ofApp.h"
+#include "ofAppNoWindow.h"
+
+//========================================================================
+int main( ){
+
+	// no window or GL context needed, the tests run headless and exit with
+	// 1 if any of them failed
+	ofAppNoWindow window;
+	ofSetupOpenGL(&window, 1024, 768, OF_WINDOW);
+
+	ofRunApp(new ofApp());
+
+}
@@ -0,0 +1,27 @@
+#include "ofApp.h"
+#include "Tests.h"
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+
+	tests::run("Codec", tests::testCodec);
+	tests::run("Parser", tests::testParser);
+	tests::run("Commands", tests::testCommands);
+	tests::run("Euler", tests::testEuler);
+	tests::run("Gestures", tests::testGestures);
+	tests::run("Histories", tests::testHistories);
+	tests::run("Features", tests::testFeatures);
+	tests::run("Predictor", tests::testPredictor);
+	tests::run("Buffers", tests::testBuffers);
+	tests::run("Connection", tests::testConnection);
+
+	ofLogNotice() << tests::getNumChecks() << " checks, " << tests::getNumFailures() << " failed";
+
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+
+	ofExit(tests::getNumFailures() > 0 ? 1 : 0);
+
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "ofMain.h"
+
+class ofApp : public ofBaseApp{
+
+public:
+	void setup();
+	void update();
+
+};
@@ -42,9 +42,9 @@ void ofApp::draw(){
 
 		ofDrawBitmapStringHighlight("Armband " + ofToString(i), 20, 20 * ++y);
 		ofDrawBitmapStringHighlight("Myo ID: " + ofToString(armband->id), 20, 20 * ++y);
-		ofDrawBitmapStringHighlight("Arm: " + armband->arm, 20, 20 * ++y);
-		ofDrawBitmapStringHighlight("X Direction: " + armband->direction, 20, 20 * ++y);
-		ofDrawBitmapStringHighlight("Pose: " + armband->pose, 20, 20 * ++y);
+		ofDrawBitmapStringHighlight("Arm: " + armband->getArmName(), 20, 20 * ++y);
+		ofDrawBitmapStringHighlight("X Direction: " + armband->getDirectionName(), 20, 20 * ++y);
+		ofDrawBitmapStringHighlight("Pose: " + armband->getPoseName(), 20, 20 * ++y);
 		ofDrawBitmapStringHighlight("Pose Confirmed: " + ofToString(armband->poseConfirmed), 20, 20 * ++y);
 		ofDrawBitmapStringHighlight("Unlocked: " + ofToString(armband->unlocked), 20, 20 * ++y);
 		
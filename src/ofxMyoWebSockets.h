@@ -7,52 +7,329 @@
 
 #pragma once
 
+#include <random>
+
 #include "ofxJSON.h"
 #include "ofxLibwebsockets.h"
 
+#include "ofxMyoWebSocketsCommandQueue.h"
+#include "ofxMyoWebSocketsEmgHistory.h"
+#include "ofxMyoWebSocketsEuler.h"
+#include "ofxMyoWebSocketsFeatures.h"
+#include "ofxMyoWebSocketsGestures.h"
+#include "ofxMyoWebSocketsImuHistory.h"
+#include "ofxMyoWebSocketsParser.h"
+#include "ofxMyoWebSocketsPolicies.h"
+#include "ofxMyoWebSocketsPredictor.h"
+#include "ofxMyoWebSocketsScheduler.h"
+#include "ofxMyoWebSocketsSharedMemory.h"
+#include "ofxMyoWebSocketsSlotPool.h"
+#include "ofxMyoWebSocketsSpscQueue.h"
+#include "ofxMyoWebSocketsStats.h"
+#include "ofxMyoWebSocketsTripleBuffer.h"
+#include "ofxMyoWebSocketsTypes.h"
+
 namespace ofxMyoWebSockets {
 
+    class Recorder;
+    class OscBridge;
+    class Hub;
+
     struct Armband {
 
         int             id;
         int             rssi;
 
-        string          arm;
-        string          direction;
-        string          pose, lastPose;
+        // Which Myo Connect host the armband is paired with, when a Hub is
+        // juggling several. Myo ids are only unique per host. 0 otherwise.
+        int             host;
+
+        // Myo Connect's timestamp of the latest message, in microseconds
+        uint64_t        timestamp;
+
+        // Set while the connection to Myo Connect is down, and until the
+        // first message for this armband after reconnecting. Everything else
+        // is kept as it was in the meantime.
+        bool            stale;
+
+        Arm             arm;
+        XDirection      direction;
+        Pose            pose, lastPose;
 
         ofVec3f         accel, gyro;
         ofQuaternion    quat;
+
+        // Filled in by update(), and before queued orientation events fire.
+        // Listeners called on the socket thread (events not queued) should
+        // use getRoll() etc. instead, which work anywhere.
         float           roll, pitch, yaw;
 
+        // Bumped whenever accel, gyro, quat or direction change. Everything
+        // derived from them below is only worked out when first asked for,
+        // and cached until the next change. Don't call these from two
+        // threads on the same Armband at once.
+        unsigned int    orientationGeneration;
+        bool            useDegrees;
+
+        float           getRoll() const { return getEulerAngles().x; }
+        float           getPitch() const { return getEulerAngles().y; }
+        float           getYaw() const { return getEulerAngles().z; }
+
+        // roll, pitch & yaw in x, y & z, same units & signs as the fields
+        const ofVec3f&      getEulerAngles() const;
+        const ofMatrix4x4&  getRotationMatrix() const;
+
+        // Acceleration in g with gravity taken out, in the world frame
+        const ofVec3f&      getLinearAccel() const;
+
+        // Angular velocity in deg/s, in the world frame
+        const ofVec3f&      getWorldGyro() const;
+
+        struct Derived {
+            unsigned int    eulerGeneration, rotationGeneration;
+            unsigned int    linearAccelGeneration, worldGyroGeneration;
+            bool            eulerDegrees;
+            ofVec3f         euler, linearAccel, worldGyro;
+            ofMatrix4x4     rotation;
+        };
+        mutable Derived derived;
+
+        // Every orientation sample received in the last few seconds, at the
+        // full rate and timestamped with the connection's clock on arrival.
+        // Filled in on the socket thread, but safe to read from anywhere.
+        ImuHistory*     history;
+
+        // Raw EMG samples, once streaming is turned on with setStreamEmg().
+        // Same deal as history: 200Hz, timestamped on arrival, safe to read
+        // from anywhere. No events fire for these, read them in bulk.
+        EmgHistory*     emgHistory;
+
+        // RMS, zero crossings, angular speed etc. over the latest window of
+        // samples, as of the last update(). Only filled in while features
+        // are turned on, see setFeaturesEnabled().
+        Features        features;
+
+        // Smoothed orientation and angular velocity as of the latest
+        // sample, for predicting where the armband is pointing at any
+        // moment. Only filled in while prediction is turned on, see
+        // setPredictionEnabled().
+        Motion          motion;
+
+        // Orientation at time, by the connection's clock (see
+        // getElapsedTimeMicros()), e.g. when the frame being drawn will be
+        // on screen. Extrapolated from the latest sample with the gyro, up
+        // to Motion::maxPrediction ahead. quat while prediction is off.
+        ofQuaternion    predictOrientation(uint64_t time) const;
+
 
         float           poseStartTime;
         bool            poseConfirmed;
         bool            unlocked;
         float           unlockStartTime;
 
+        // The last pose sequence performed, as an index into the armband's
+        // GesturePolicy::sequences, -1 if none yet
+        int             sequence;
+
+        // Names as sent by Myo Connect, e.g. "fist" or "toward_wrist"
+        string          getPoseName() const { return toString(pose); }
+        string          getLastPoseName() const { return toString(lastPose); }
+        string          getArmName() const { return toString(arm); }
+        string          getDirectionName() const { return toString(direction); }
+
     };
 
 
-    class Connection {
+    // Armband plus the bookkeeping needed to hand its state over from the
+    // socket thread to the main thread
+    struct ArmbandState : public Armband {
+
+        // When the pose gets confirmed and the armband locks again, by the
+        // connection's clock, 0 if nothing's pending. Compared against
+        // what the scheduler hands back, so overtaken deadlines do nothing.
+        uint64_t        poseDeadline;
+        uint64_t        unlockDeadline;
+
+        int             slot;   // in the ingest pool, for stats
+
+    };
+
+
+    typedef SlotHandle ArmbandHandle;
+
+
+    // Compact record of an event raised on the socket thread, queued up to
+    // be fired from update() when queued events are turned on
+    struct QueuedEvent {
+
+        enum Type {
+            PAIRED,
+            UNPAIRED,
+            CONNECTED,
+            DISCONNECTED,
+            ARM_RECOGNIZED,
+            ARM_LOST,
+            ARM_SYNCED,
+            ARM_UNSYNCED,
+            UNLOCKED,
+            LOCKED,
+            POSE_STARTED,
+            POSE_CONFIRMED,
+            POSE_SEQUENCE,
+            ORIENTATION,
+            RSSI_RECEIVED
+        };
+
+        Type            type;
+        int             myo;
+        uint64_t        received;   // by the connection's clock, on arrival
+
+        // sensor data at the time of the event, Euler angles are worked out
+        // when it's fired
+        int             rssi;
+        float           accel[3], gyro[3], quat[4];
+
+        // likewise poses and locking, which may well have moved on by the
+        // time it's fired
+        Pose            pose, lastPose;
+        bool            unlocked, poseConfirmed;
+        int             sequence;
+
+    };
+
+
+    // Everything's decided at runtime in Connection. Pick policies of your
+    // own to fix some of it at compile time, see ofxMyoWebSocketsPolicies.h.
+    //
+    // This is the openFrameworks side of the addon: the socket, the
+    // armbands' ofVec3f & ofQuaternion, events and logging. It runs without
+    // a window or an app loop (see startUpdateThread()), but not without
+    // openFrameworks. What it's built from (histories, parsing, gestures,
+    // features, prediction, stats, the scheduler, shared memory) only needs
+    // the standard library.
+    template<class Policies>
+    class BasicConnection {
 
     public:
 
-        Connection();
+        BasicConnection();
+        ~BasicConnection();
+
         void connect(bool autoReconnect = false);
         void connect(string hostname = "localhost", int port = 10138, bool autoReconnect = false);
+        bool isConnected() { return connected; }
+
+        // Reconnect attempts start after minimum seconds and back off
+        // exponentially up to maximum, with some random jitter. 0.25 and 10
+        // seconds by default.
+        void setReconnectDelay(float minimum, float maximum);
+
+        // Armbands are kept when the connection drops, marked stale. Those
+        // not heard from again within this long of reconnecting are dropped,
+        // with a disconnected event. 3 seconds by default.
+        void setStaleTimeout(float seconds);
 
 		void setLockingPolicy(string type);
         void setRequiresUnlock(bool require = false);
         void setUnlockTimeout(float time = 3.0f);
         void setMinimumGestureDuration(float time = 0.0f);
         void setLockAfterPose(bool lock = true);
+
+        // The whole set of pose confirmation & locking rules at once, for
+        // every armband, or for one armband in particular. The setters
+        // above change the policy for every armband.
+        void setGesturePolicy(const GesturePolicy& policy);
+        void setGesturePolicy(int myoID, const GesturePolicy& policy);
+        void clearGesturePolicy(int myoID);
+        const GesturePolicy& getGesturePolicy(int myoID = -1);
         void setUseDegrees(bool degrees = true);
 
-        float getMinimumGestureDuration() { return minimumGestureDuration; }
+        // Stamped on Armband::host for every armband, used by Hub. Call
+        // before connect().
+        void setHost(int host);
+        int getHost() { return host; }
+
+        // Fire events from update() on the main thread, in the order they
+        // arrived, instead of straight from the socket thread. Call this
+        // before connect(). Events which don't fit in the queue are dropped.
+        void setQueuedEvents(bool queued = true, int capacity = 1024);
+
+        // When queued, only fire the latest orientation event per armband
+        void setCoalesceOrientationEvents(bool coalesce = true);
+
+        unsigned int getDroppedEventCount() { return droppedEvents; }
+        unsigned int getCoalescedEventCount() { return coalescedEvents; }
+
+        // Message rates, handling times, gaps in the orientation stream etc.
+        // Off by default, and close to free while off. Rates in getStats()
+        // cover the time since the previous call, so call it from one place.
+        void setStatsEnabled(bool enabled = true);
+        Stats getStats();
+        void resetStats();
+
+        // Log getStats() every so often from update(), 0 to stop. Turns on
+        // stats if they aren't already.
+        void setStatsLogInterval(float seconds);
+
+        // Write every message received from Myo Connect to recorder, or
+        // pass NULL to stop
+        void setRecorder(Recorder* recorder);
+
+        // Publish every armband's state and orientation history to other
+        // local processes through publisher, or pass NULL to stop. Open it
+        // first, and don't close it while it's set here. Once this returns
+        // the socket thread is done with the previous one.
+        void setSharedMemory(SharedMemoryPublisher* publisher);
+
+        // Send orientation, poses and locking over OSC through bridge
+        // straight from the socket thread, or pass NULL to stop. Set it up
+        // first, and don't close it while it's set here. Like
+        // setSharedMemory(), waits for the socket thread to let go of the
+        // previous one.
+        void setOscBridge(OscBridge* bridge);
+
+        // Handle a raw message as if it had come from Myo Connect, e.g. to
+        // replay a recording (see Player). The calling thread takes the
+        // place of the socket thread, so don't do this while connected.
+        void processMessage(const string& message);
+
+        float getMinimumGestureDuration() { return gestures.getPolicy().minimumGestureDuration; }
 
         void update();
 
+        // Microseconds from a monotonic clock
+        typedef Scheduler::Clock Clock;
+
+        // Where every timestamp comes from (history, stats, pose & unlock
+        // start times, reconnect delays etc.). Scheduler::getSteadyMicros()
+        // by default, which needs no ofApp and is the same for every
+        // connection, but isn't ofGetElapsedTimeMicros(). Every thread reads it
+        // without a lock, so call it first: it's ignored once connect() or
+        // startUpdateThread() has been called, or a deadline's scheduled.
+        // With a clock that isn't real time, deadlines (pose confirmation,
+        // the unlock timeout) are only caught up with in update().
+        void setClock(Clock clock);
+        uint64_t getElapsedTimeMicros() { return clock(); }
+        float getElapsedTimef() { return clock() / 1000000.0; }
+
+        // For apps without an update loop, e.g. headless services: calls
+        // update() from a thread of its own, as soon as the socket thread
+        // has something new and every interval seconds otherwise (for
+        // reconnecting, stats etc.). Listeners are then called from that
+        // thread, and the armbands are only safe to read from them. Don't
+        // call update() yourself while it's running.
+        void startUpdateThread(float interval = 0.1f);
+        void stopUpdateThread();
+        bool isUpdateThreadRunning() { return updateThreadRunning; }
+
+        // Commands are queued and sent from a background thread once per
+        // update(). Repeats of vibrate, notify_user_action and request_rssi
+        // to the same armband within the window (0.1 seconds by default)
+        // are dropped, pass 0 to send every one.
+        void setCommandDedupWindow(float seconds);
+        unsigned int getSentCommandCount() { return commands.getSentCount(); }
+        unsigned int getDeduplicatedCommandCount() { return commands.getDeduplicatedCount(); }
+
         void sendCommand(string command, string parameter);
         void sendCommand(int myoID, string command);
         void sendCommand(int myoID, string command, string type);
@@ -76,11 +353,62 @@ namespace ofxMyoWebSockets {
 		void unlock(int myoID, string type);
 		void unlock(Armband* armband, string type);
 
+        // Armbands as of the last call to update(). These are only ever
+        // modified in update(), so they're safe to read from the main thread
+        // for the rest of the frame.
         vector<Armband*>    armbands;
         Armband*            getArmband(int myoID);
         Armband*            createArmband(int myoID);
+
+        // Like getArmband(), but NULL rather than a new, empty armband if
+        // there isn't one with that id
+        Armband*            findArmband(int myoID);
         int                 numConnectedArmbands();
 
+        // Armbands live in a fixed-size pool (16 by default), so pointers to
+        // them are never invalidated, but a slot is reused once its armband
+        // is unpaired or disconnected. Hold on to a handle instead of a
+        // pointer to find out: getArmband(handle) returns NULL once the
+        // armband is gone. Call setMaxArmbands() before connect() (or
+        // processMessage()), it's ignored after.
+        ArmbandHandle       getArmbandHandle(int myoID);
+        Armband*            getArmband(ArmbandHandle handle);
+        void                setMaxArmbands(int count);
+
+        // Number of orientation samples kept per armband in Armband::history,
+        // 256 by default. Call before connect(), it's ignored after.
+        void                setImuHistorySize(int samples);
+
+        // Raw EMG from all 8 sensors, at 200Hz, into Armband::emgHistory.
+        // Off by default. Myo Connect forgets this when the armband or the
+        // connection drops, so it's turned back on when they come back.
+        void                setStreamEmg(int myoID, bool enabled = true);
+        void                setStreamEmg(Armband* armband, bool enabled = true);
+
+        // Number of EMG samples kept per armband in Armband::emgHistory,
+        // 1024 by default. Call before connect(), it's ignored after.
+        void                setEmgHistorySize(int samples);
+
+        // Keep Armband::features up to date as samples come in. Off by
+        // default, and free while off.
+        void                setFeaturesEnabled(bool enabled = true);
+
+        // Window lengths in samples, 40 EMG samples (0.2s at 200Hz) and 10
+        // IMU samples (0.2s at 50Hz) by default. Starts the windows over.
+        void                setFeatureWindows(int emgSamples, int imuSamples);
+
+        // Keep Armband::motion up to date for predictOrientation(). Off by
+        // default.
+        void                setPredictionEnabled(bool enabled = true);
+
+        // Smoothing, see OrientationPredictor::setFilter(). 1Hz and 1 by
+        // default, a minCutoff of 0 turns it off.
+        void                setPredictionFilter(float minCutoff, float beta);
+
+        // How far ahead predictOrientation() extrapolates at most, 0.1
+        // seconds by default
+        void                setMaxPrediction(float seconds);
+
         ofEvent<Armband>    pairedEvent;
         ofEvent<Armband>    unpairedEvent;
 
@@ -101,6 +429,10 @@ namespace ofxMyoWebSockets {
         ofEvent<Armband>    poseStartedEvent;
         ofEvent<Armband>    poseConfirmedEvent;
 
+        // One of the armband's GesturePolicy::sequences was performed, see
+        // Armband::sequence
+        ofEvent<Armband>    poseSequenceEvent;
+
         ofEvent<Armband>    orientationEvent;
         ofEvent<Armband>    rssiReceivedEvent;
 
@@ -116,22 +448,244 @@ namespace ofxMyoWebSockets {
         ofxLibwebsockets::Client    client;
         
     private:
-        
-        bool    connected;
+
+        // ingestMutex, remembering which thread has it so that settings
+        // changed from its listeners can apply straight away. The
+        // scheduler's thread doesn't wait for it.
+        class IngestLock {
+        public:
+            IngestLock(BasicConnection& connection, bool wait = true);
+            ~IngestLock();
+            bool    ownsLock() { return lock.owns_lock(); }
+        private:
+            BasicConnection&                        connection;
+            std::unique_lock<std::recursive_mutex>  lock;
+            std::thread::id                         previous;
+        };
+
+        void    handleMessage(const string& message, const Json::Value* json, uint64_t timestamp);
+        void    onOrientation(ArmbandState* armband, const OrientationFrame& frame, uint64_t timestamp);
+        void    onEmg(ArmbandState* armband, const EmgFrame& frame, uint64_t timestamp);
+
+        // Sets roll, pitch & yaw from angles in radians, converting to
+        // degrees and flipping for the armband's direction as needed
+        void    setEulerAngles(Armband* armband, float roll, float pitch, float yaw);
+
+        Clock           clock;
+        bool            realTimeClock;  // the default one
+
+        // Update thread, woken by the socket thread whenever it publishes
+        // armbands or queues an event
+        void    updateThreadFunction();
+        void    wakeUpdateThread();
+
+        std::thread                 updateThread;
+        std::mutex                  updateMutex;
+        std::condition_variable     updateCondition;
+        std::atomic<bool>           updateThreadRunning;
+        std::atomic<bool>           updatePending;
+        float                       updateInterval;
+
+        std::atomic<Recorder*>  recorder;
+
+        // Only touched under ingestMutex, set through configure()
+        SharedMemoryPublisher*  sharedMemory;
+        void    publishSharedMemory(const ArmbandState& armband);
+
+        // Same deal
+        OscBridge*  oscBridge;
+        void    publishOsc();
+
+        CommandQueue    commands;
+
+        StatsCollector  stats;
+        uint64_t        messageTime;    // arrival of the message being handled
+        float           statsLogInterval;
+        float           statsLastLog;
+
+        void                notify(QueuedEvent::Type type, Armband* armband);
+        ofEvent<Armband>&   getEvent(QueuedEvent::Type type);
+
+        void    initArmband(ArmbandState* armband, int myoID, bool requiresUnlock);
+
+        // What the socket thread hands over to update(): its armbands by
+        // ingest slot, and the slots in use in the order their armbands
+        // came along. Each buffer only copies the armbands that changed
+        // since it was last filled, going by versions.
+        struct Snapshot {
+            vector<ArmbandState>    armbands;
+            vector<unsigned int>    versions;
+            vector<int>             slots;
+        };
+
+        // socket thread. publishArmband() when one armband has changed,
+        // publishArmbands() when any of them may have, and publishSnapshot()
+        // when armbands have only gone.
+        ArmbandState*   getIngestArmband(int myoID);
+        void            removeIngestArmband(int myoID);
+        void            publishArmband(ArmbandState* armband);
+        void            publishArmbands();
+        void            publishSnapshot();
+
+        SlotPool<ArmbandState>                  ingestArmbands;
+        vector<unsigned int>                    ingestVersions;     // by slot, bumped on every change
+        vector<ImuHistory>                      imuHistories;
+        vector<ImuHistory*>                     freeImuHistories;
+        vector<EmgHistory>                      emgHistories;
+        vector<EmgHistory*>                     freeEmgHistories;
+        TripleBuffer<Snapshot>                  snapshots;
+
+        SpscQueue<QueuedEvent>      eventQueue;
+        std::atomic<unsigned int>   droppedEvents;
+
+
+        // main thread
+        SlotPool<ArmbandState>      armbandPool;
+
+        void            syncArmbands();
+        void            releaseRemovedArmbands();
+
+        // update() in pieces, so Hub can fire every host's queued events in
+        // the order they arrived: beginUpdate() syncs the armbands, then
+        // the queued events are fired one at a time (peekQueuedEvent() is
+        // NULL once they're all out), then endUpdate()
+        friend class Hub;
+        void                beginUpdate();
+        void                collectQueuedEvents();
+        const QueuedEvent*  peekQueuedEvent();
+        void                fireQueuedEvent();
+        void                endUpdate();
+        bool                armbandsChanged;
+
+        // Reconnecting. openSocket() may be called over and over, the
+        // listener is only added once.
+        void            openSocket();
+        float           getReconnectDelay();
+        void            resync();
+        void            expireStaleArmbands();
+
+        EulerBatch                  eulerBatch;
+        vector<Armband*>            eulerArmbands;
+
+        vector<QueuedEvent>         pendingEvents;
+        int                         nextEvent;
+        int                         eulerIndex;
+        vector<char>                supersededEvents;
+        vector<int>                 coalescedArmbands;
+        unsigned int                coalescedEvents;
+
+        std::atomic<bool>   connected;
+        bool    wasConnected;
+        bool    listening;
+
+        // Once anything's been connected or processed, the clock, pools and
+        // histories are in use on other threads and stay as they are
+        std::atomic<bool>   started;
+        bool    isStarted();
+
+        // Settings the socket thread uses go through here, so the main
+        // thread never waits on ingestMutex. Changes are applied in order
+        // under ingestMutex, by the next message or straight away by the
+        // scheduler's thread. Before the connection starts, or from a
+        // listener that already holds ingestMutex, they apply right here.
+        // wait blocks until the change has been applied.
+        void    configure(const std::function<void()>& change, bool wait = false);
+        void    applyConfigChanges();
+
+        SpscQueue< std::function<void()> >  configChanges;
+        unsigned int                        configQueued;   // main thread
+        std::atomic<unsigned int>           configApplied;
+        std::atomic<std::thread::id>        ingestThread;   // holding ingestMutex
+
         bool    reconnect;
-        float   reconnectTime;
+        float   reconnectTime;      // until the next attempt
         float   reconnectLastAttempt;
+        float   reconnectMinDelay;
+        float   reconnectMaxDelay;
+        int     reconnectAttempts;
+        std::minstd_rand    reconnectRandom;    // jitter, main thread
+
+        string  lockingPolicy;
+        float   staleTimeout;
+
+        // socket & scheduler threads, under ingestMutex
+        bool    resyncing;
+        uint64_t staleDeadline;
 
         string  hostname;
         int     port;
+        int     host;
         
-        bool    requiresUnlock;
-        float   unlockTimeout;
-        float   minimumGestureDuration;
-        bool    lockAfterPose;
-        
-        bool    convertToDegrees;
+        typename Policies::Units        units;
+        typename Policies::Dispatch     dispatch;
+
+        bool    coalesceOrientation;
+
+        // Pose confirmation and locking, on the socket thread or the
+        // scheduler's, whichever gets there first. Both hold ingestMutex
+        // while touching the ingest armbands, and fire (or queue) events
+        // just the same. The scheduler's thread only ever try_lock()s it,
+        // leaving the deadline to the socket thread's next poll() if it's
+        // busy, so it never holds up a message. DEADLINE_STALE is for the
+        // connection as a whole, when armbands still stale after
+        // reconnecting are dropped, whether or not messages come in.
+        // DEADLINE_CONFIG applies queued configure() changes.
+        enum Deadline {
+            DEADLINE_POSE,
+            DEADLINE_UNLOCK,
+            DEADLINE_STALE,
+            DEADLINE_CONFIG
+        };
+
+        void    startScheduler();
+        void    scheduleDeadline(ArmbandState* armband, Deadline kind, float seconds);
+        bool    onDeadline(int myoID, int kind, uint64_t deadline);
+        void    runGestureActions(ArmbandState* armband, GestureMachine::Trigger trigger);
+        void    unlockArmband(ArmbandState* armband);
+        void    lockArmband(ArmbandState* armband);
+
+        // Per-armband policy if there is one, otherwise the default. The
+        // main thread's copies and the socket thread's.
+        const GestureMachine&   getGestures(int myoID);
+        const GestureMachine&   getIngestGestures(int myoID);
+        void    applyGesturePolicies();
+
+        std::recursive_mutex    ingestMutex;
+
+        // Compiled policies. The main thread compiles them, and hands
+        // copies to the socket thread through configure().
+        GestureMachine                  gestures;
+        std::map<int, GestureMachine>   armbandGestures;
+        GestureMachine                  ingestGestures;
+        std::map<int, GestureMachine>   ingestArmbandGestures;
+
+        // Recent poses for matching sequences, by ingest slot
+        vector<PoseHistory>         poseHistories;
+
+        // Myo ids to stream EMG from, changed through configure()
+        vector<int>                 emgStreaming;
+
+        // Sliding window features by ingest slot, and whether to bother
+        vector<FeatureExtractor>    featureExtractors;
+        std::atomic<bool>           featuresEnabled;
+
+        // Orientation predictors by ingest slot, same deal
+        vector<OrientationPredictor>    predictors;
+        std::atomic<bool>               predictionEnabled;
+
+        // last, so it stops before anything its callback touches goes away
+        Scheduler       scheduler;
         
     };
+
+    typedef BasicConnection<DefaultPolicies> Connection;
+
+    // compiled once, in ofxMyoWebSockets.cpp
+    extern template class BasicConnection<DefaultPolicies>;
     
-}
\ No newline at end of file
+}
+
+#include "ofxMyoWebSocketsRecorder.h"
+#include "ofxMyoWebSocketsOscBridge.h"
+#include "ofxMyoWebSocketsConnectionImpl.h"
+#include "ofxMyoWebSocketsHub.h"
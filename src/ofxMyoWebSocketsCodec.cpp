@@ -0,0 +1,238 @@
+//
+//  ofxMyoWebSocketsCodec
+//
+
+#include "ofxMyoWebSocketsCodec.h"
+
+#include <math.h>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    // Fixed point scales, per g and per deg/s
+    const float accelScale = 2048.0f;
+    const float gyroScale = 16.0f;
+
+    // The three smallest components of a unit quaternion are within this
+    // of 0
+    const float quatRange = 0.70710678f;
+
+    //--------------------------------------------------------------
+    size_t writeVarint(uint64_t value, uint8_t* out){
+        size_t length = 0;
+        while (value >= 0x80) {
+            out[length++] = (uint8_t)(value | 0x80);
+            value >>= 7;
+        }
+        out[length++] = (uint8_t)value;
+        return length;
+    }
+
+    //--------------------------------------------------------------
+    bool readVarint(const uint8_t* data, size_t size, size_t& position, uint64_t& value){
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position >= size) return false;
+            uint8_t byte = data[position++];
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    //--------------------------------------------------------------
+    void writeFixed(float value, float scale, uint8_t* out){
+        float scaled = roundf(value * scale);
+        int16_t fixed = scaled > 32767 ? 32767 : scaled < -32768 ? -32768 : (int16_t)scaled;
+        out[0] = (uint8_t)fixed;
+        out[1] = (uint8_t)((uint16_t)fixed >> 8);
+    }
+
+    //--------------------------------------------------------------
+    float readFixed(const uint8_t* data, float scale){
+        int16_t fixed = (int16_t)(data[0] | (data[1] << 8));
+        return fixed / scale;
+    }
+
+    //--------------------------------------------------------------
+    size_t writeQuat(const float quat[4], int bits, uint8_t* out){
+
+        float q[4] = { quat[0], quat[1], quat[2], quat[3] };
+        float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        if (length > 0) {
+            for (int i = 0; i < 4; i++) q[i] /= length;
+        } else {
+            q[0] = q[1] = q[2] = 0;
+            q[3] = 1;
+        }
+
+        int largest = 0;
+        for (int i = 1; i < 4; i++) {
+            if (fabsf(q[i]) > fabsf(q[largest])) largest = i;
+        }
+
+        // q and -q are the same rotation, so make the largest positive and
+        // leave its sign out
+        float sign = q[largest] < 0 ? -1 : 1;
+
+        uint32_t steps = (1 << bits) - 1;
+        uint64_t packed = largest;
+
+        for (int i = 0; i < 4; i++) {
+            if (i == largest) continue;
+            float normalized = (q[i] * sign + quatRange) / (2 * quatRange);
+            float scaled = roundf(normalized * steps);
+            uint32_t value = scaled < 0 ? 0 : scaled > steps ? steps : (uint32_t)scaled;
+            packed = (packed << bits) | value;
+        }
+
+        size_t bytes = (2 + 3 * bits + 7) / 8;
+        for (size_t i = 0; i < bytes; i++) {
+            out[i] = (uint8_t)(packed >> (i * 8));
+        }
+
+        return bytes;
+
+    }
+
+    //--------------------------------------------------------------
+    void readQuat(const uint8_t* data, int bits, float quat[4]){
+
+        size_t bytes = (2 + 3 * bits + 7) / 8;
+        uint64_t packed = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            packed |= (uint64_t)data[i] << (i * 8);
+        }
+
+        uint32_t steps = (1 << bits) - 1;
+        int largest = (packed >> (3 * bits)) & 3;
+
+        float sum = 0;
+        int shift = 2 * bits;
+        for (int i = 0; i < 4; i++) {
+            if (i == largest) continue;
+            uint32_t value = (packed >> shift) & steps;
+            quat[i] = (float)value / steps * 2 * quatRange - quatRange;
+            sum += quat[i] * quat[i];
+            shift -= bits;
+        }
+
+        quat[largest] = sqrtf(sum < 1 ? 1 - sum : 0);
+
+    }
+
+}
+
+//--------------------------------------------------------------
+SampleEncoder::SampleEncoder(int quatBits){
+    this->quatBits = quatBits == 32 ? 10 : 15;
+    lastTimestamp = 0;
+}
+
+//--------------------------------------------------------------
+size_t SampleEncoder::encode(int myo, uint64_t timestamp, const float accel[3], const float gyro[3], const float quat[4], uint8_t* out){
+
+    size_t size = writeVarint((uint32_t)myo, out);
+
+    // zigzag, so small steps back stay small
+    int64_t delta = (int64_t)(timestamp - lastTimestamp);
+    size += writeVarint(((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63), out + size);
+    lastTimestamp = timestamp;
+
+    size += writeQuat(quat, quatBits, out + size);
+
+    for (int i = 0; i < 3; i++) {
+        writeFixed(accel[i], accelScale, out + size);
+        size += 2;
+    }
+    for (int i = 0; i < 3; i++) {
+        writeFixed(gyro[i], gyroScale, out + size);
+        size += 2;
+    }
+
+    return size;
+
+}
+
+//--------------------------------------------------------------
+size_t SampleEncoder::encode(const Sample* samples, int count, uint8_t* out){
+
+    size_t size = 0;
+    for (int i = 0; i < count; i++) {
+        const Sample& sample = samples[i];
+        size += encode(sample.myo, sample.timestamp, sample.accel, sample.gyro, sample.quat, out + size);
+    }
+
+    return size;
+
+}
+
+//--------------------------------------------------------------
+size_t SampleEncoder::encode(int myo, const ImuSamples& samples, uint8_t* out){
+
+    size_t size = 0;
+    for (int i = 0; i < samples.size(); i++) {
+        float accel[3], gyro[3], quat[4];
+        for (int j = 0; j < 3; j++) {
+            accel[j] = samples.accel(i, j);
+            gyro[j] = samples.gyro(i, j);
+        }
+        for (int j = 0; j < 4; j++) {
+            quat[j] = samples.quat(i, j);
+        }
+        size += encode(myo, samples.timestamp(i), accel, gyro, quat, out + size);
+    }
+
+    return size;
+
+}
+
+//--------------------------------------------------------------
+SampleDecoder::SampleDecoder(int quatBits){
+    this->quatBits = quatBits == 32 ? 10 : 15;
+    lastTimestamp = 0;
+}
+
+//--------------------------------------------------------------
+int SampleDecoder::decode(const uint8_t* data, size_t length, Sample* samples, int maxSamples, size_t* used){
+
+    size_t quatBytes = (2 + 3 * quatBits + 7) / 8;
+    size_t position = 0;
+    int count = 0;
+
+    while (count < maxSamples) {
+
+        size_t start = position;
+        uint64_t myo, delta;
+
+        if (!readVarint(data, length, position, myo) ||
+            !readVarint(data, length, position, delta) ||
+            length - position < quatBytes + 12) {
+            position = start;
+            break;
+        }
+
+        Sample& sample = samples[count++];
+        sample.myo = (int)(uint32_t)myo;
+
+        lastTimestamp += (int64_t)(delta >> 1) ^ -(int64_t)(delta & 1);
+        sample.timestamp = lastTimestamp;
+
+        readQuat(data + position, quatBits, sample.quat);
+        position += quatBytes;
+
+        for (int i = 0; i < 3; i++) {
+            sample.accel[i] = readFixed(data + position, accelScale);
+            position += 2;
+        }
+        for (int i = 0; i < 3; i++) {
+            sample.gyro[i] = readFixed(data + position, gyroScale);
+            position += 2;
+        }
+    }
+
+    if (used) *used = position;
+    return count;
+
+}
@@ -0,0 +1,90 @@
+//
+//  ofxMyoWebSocketsCodec
+//
+//  Compact binary encoding of orientation samples, for logging or sending
+//  lots of them: about 21 bytes a sample instead of the 300 or so of Myo
+//  Connect's JSON. Each sample is
+//
+//      varint          myo id
+//      varint          microseconds since the previous sample in the
+//                      stream, zigzag encoded so it may go backwards
+//      4 or 6 bytes    quaternion, smallest three: the index of the
+//                      largest component in 2 bits, then the other three
+//                      in 10 or 15 bits each (the largest is worked out
+//                      from them, as the quaternion is a unit one)
+//      3 x int16       accelerometer, 1/2048 g (the Myo's own resolution)
+//      3 x int16       gyroscope, 1/16 deg/s (likewise)
+//
+//  all little endian. 48 bit quaternions are good to within 0.01 degrees,
+//  32 bit ones to within 0.25. There's no header, so the encoder & decoder
+//  need to agree on the quaternion size and start on the same sample.
+//
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ofxMyoWebSocketsImuHistory.h"
+
+namespace ofxMyoWebSockets {
+
+    struct Sample {
+        int         myo;
+        uint64_t    timestamp;      // microseconds, from any clock
+        float       accel[3];       // g
+        float       gyro[3];        // deg/s
+        float       quat[4];        // x, y, z, w
+    };
+
+    class SampleEncoder {
+
+    public:
+
+        // quatBits: 32 or 48
+        SampleEncoder(int quatBits = 48);
+
+        // Start a new stream, timestamps are relative to 0 again
+        void            reset() { lastTimestamp = 0; }
+
+        // Encodes count samples into out, which needs room for
+        // getMaxSize(count) bytes. Returns the number of bytes written.
+        size_t          encode(const Sample* samples, int count, uint8_t* out);
+
+        // Same for a window of an armband's history, e.g. from getFrom()
+        size_t          encode(int myo, const ImuSamples& samples, uint8_t* out);
+
+        static size_t   getMaxSize(int count) { return count * maxSampleSize; }
+        static const int    maxSampleSize = 5 + 10 + 6 + 12;
+
+    private:
+
+        size_t          encode(int myo, uint64_t timestamp, const float accel[3], const float gyro[3], const float quat[4], uint8_t* out);
+
+        int             quatBits;
+        uint64_t        lastTimestamp;
+
+    };
+
+    class SampleDecoder {
+
+    public:
+
+        SampleDecoder(int quatBits = 48);
+
+        void            reset() { lastTimestamp = 0; }
+
+        // Decodes up to maxSamples whole samples from data. Returns the
+        // number decoded, and the number of bytes they took in used if it
+        // isn't NULL, so a partial sample at the end can be carried over
+        // to the next call.
+        int             decode(const uint8_t* data, size_t length, Sample* samples, int maxSamples, size_t* used = NULL);
+
+    private:
+
+        int             quatBits;
+        uint64_t        lastTimestamp;
+
+    };
+
+}
@@ -0,0 +1,217 @@
+//
+//  ofxMyoWebSocketsCommandQueue
+//
+
+#include "ofxMyoWebSocketsCommandQueue.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    // JSON string contents, escaped. Returns false if out runs out of room.
+    bool appendString(char*& out, char* end, const std::string& value) {
+
+        for (size_t i = 0; i < value.size(); i++) {
+
+            unsigned char c = value[i];
+
+            if (c == '"' || c == '\\') {
+                if (end - out < 2) return false;
+                *out++ = '\\';
+                *out++ = c;
+            }
+            else if (c < 0x20) {
+                if (end - out < 6) return false;
+                snprintf(out, 7, "\\u%04x", c);
+                out += 6;
+            }
+            else {
+                if (end - out < 1) return false;
+                *out++ = c;
+            }
+        }
+
+        return true;
+
+    }
+
+    bool appendLiteral(char*& out, char* end, const char* literal) {
+        size_t length = strlen(literal);
+        if (end - out < (ptrdiff_t)length) return false;
+        memcpy(out, literal, length);
+        out += length;
+        return true;
+    }
+
+}
+
+//--------------------------------------------------------------
+CommandQueue::CommandQueue(){
+
+    running = false;
+    flushRequested = false;
+    dedupWindow = 100000;
+
+    queued.reserve(capacity);
+    recent.reserve(capacity);
+    sending.reserve(capacity);
+    message.reserve(maxLength);
+
+    sent = 0;
+    deduplicated = 0;
+    dropped = 0;
+
+}
+
+//--------------------------------------------------------------
+CommandQueue::~CommandQueue(){
+    stop();
+}
+
+//--------------------------------------------------------------
+void CommandQueue::start(Sender sender){
+
+    stop();
+
+    this->sender = sender;
+    running = true;
+    thread = std::thread(&CommandQueue::threadedFunction, this);
+
+}
+
+//--------------------------------------------------------------
+void CommandQueue::stop(){
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    condition.notify_one();
+
+    if (thread.joinable()) thread.join();
+
+}
+
+//--------------------------------------------------------------
+void CommandQueue::setDedupWindow(uint64_t micros){
+    std::lock_guard<std::mutex> lock(mutex);
+    dedupWindow = micros;
+}
+
+//--------------------------------------------------------------
+bool CommandQueue::isDeduplicated(const std::string& command){
+    return command == "vibrate" || command == "notify_user_action" || command == "request_rssi";
+}
+
+//--------------------------------------------------------------
+size_t CommandQueue::serialize(char* out, size_t size, int myoID, const std::string& command, const std::string& type){
+
+    char* p = out;
+    char* end = out + size;
+
+    if (!appendLiteral(p, end, "[\"command\",{\"command\":\"") ||
+        !appendString(p, end, command) ||
+        !appendLiteral(p, end, "\"")) return 0;
+
+    if (myoID != -1) {
+        char id[24];
+        snprintf(id, sizeof(id), ",\"myo\":%d", myoID);
+        if (!appendLiteral(p, end, id)) return 0;
+    }
+
+    if (!appendLiteral(p, end, ",\"type\":\"") ||
+        !appendString(p, end, type) ||
+        !appendLiteral(p, end, "\"}]")) return 0;
+
+    return p - out;
+
+}
+
+//--------------------------------------------------------------
+bool CommandQueue::push(int myoID, const std::string& command, const std::string& type, uint64_t now){
+
+    Command entry;
+    entry.length = serialize(entry.text, maxLength, myoID, command, type);
+    entry.time = now;
+
+    if (entry.length == 0) {
+        dropped++;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (dedupWindow > 0 && isDeduplicated(command)) {
+
+        // forget whatever has fallen out of the window
+        for (int i = recent.size() - 1; i >= 0; i--) {
+            if (now - recent[i].time >= dedupWindow) {
+                recent[i] = recent.back();
+                recent.pop_back();
+            }
+        }
+
+        for (int i = 0; i < recent.size(); i++) {
+            if (recent[i].length == entry.length && memcmp(recent[i].text, entry.text, entry.length) == 0) {
+                deduplicated++;
+                return false;
+            }
+        }
+
+        if (recent.size() < capacity) recent.push_back(entry);
+    }
+
+    if (queued.size() >= capacity) {
+        dropped++;
+        return false;
+    }
+
+    queued.push_back(entry);
+    return true;
+
+}
+
+//--------------------------------------------------------------
+void CommandQueue::flush(){
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // nobody to send them to yet, so they wait for start()
+        if (queued.empty() || !running) return;
+
+        flushRequested = true;
+    }
+
+    condition.notify_one();
+
+}
+
+//--------------------------------------------------------------
+void CommandQueue::threadedFunction(){
+
+    while (true) {
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]{ return flushRequested || !running; });
+            if (!running) return;
+
+            // take the whole batch, so commands queued meanwhile don't wait
+            // on the socket
+            sending.swap(queued);
+            flushRequested = false;
+        }
+
+        for (int i = 0; i < sending.size(); i++) {
+            message.assign(sending[i].text, sending[i].length);
+            sender(message);
+            sent++;
+        }
+
+        sending.clear();
+    }
+
+}
@@ -0,0 +1,106 @@
+//
+//  ofxMyoWebSocketsCommandQueue
+//
+//  Outgoing commands for Myo Connect. Commands are serialized straight into
+//  fixed-size buffers (no JSON tree), queued from any thread and handed to
+//  a writer thread in one batch per flush(), so neither update() nor the
+//  socket thread ever waits on a socket write.
+//
+//  Commands with a one-off effect (vibrate, notify_user_action and
+//  request_rssi) are dropped when an identical one was queued within the
+//  dedup window, e.g. the same band being told to vibrate on every frame.
+//  Everything else (lock, unlock, set_locking_policy etc.) is order
+//  sensitive and always goes through.
+//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ofxMyoWebSockets {
+
+    class CommandQueue {
+
+    public:
+
+        typedef std::function<void(const std::string&)> Sender;
+
+        CommandQueue();
+        ~CommandQueue();
+
+        // Start the writer thread, which hands each message to sender. Until
+        // then, commands stay queued (up to capacity) for the first flush()
+        // after it.
+        void            start(Sender sender);
+        void            stop();
+        bool            isRunning() { return thread.joinable(); }
+
+        // Microseconds, 0 to send every command
+        void            setDedupWindow(uint64_t micros);
+
+        // Any thread. now is in microseconds, from the same clock every
+        // time. Returns false if the command was deduplicated or dropped.
+        bool            push(int myoID, const std::string& command, const std::string& type, uint64_t now);
+
+        // Hand everything queued so far to the writer thread, once a frame
+        void            flush();
+
+        unsigned int    getSentCount() { return sent; }
+        unsigned int    getDeduplicatedCount() { return deduplicated; }
+
+        // Commands which didn't fit in the queue, or were too long to
+        // serialize
+        unsigned int    getDroppedCount() { return dropped; }
+
+        // ["command",{"command":"vibrate","myo":0,"type":"short"}], the same
+        // as the JSON ofxJSON would write. myoID -1 leaves out "myo".
+        // Returns the length, or 0 if it doesn't fit.
+        static size_t   serialize(char* out, size_t size, int myoID, const std::string& command, const std::string& type);
+
+        static const int    maxLength = 192;
+        static const int    capacity = 256;
+
+    private:
+
+        struct Command {
+            char        text[maxLength];
+            size_t      length;
+            uint64_t    time;
+        };
+
+        static bool     isDeduplicated(const std::string& command);
+
+        void            threadedFunction();
+
+        std::mutex              mutex;
+        std::condition_variable condition;
+        std::thread             thread;
+        bool                    running;
+        bool                    flushRequested;
+
+        Sender                  sender;
+
+        // guarded by mutex
+        std::vector<Command>    queued;
+        std::vector<Command>    recent;     // for deduplication
+        uint64_t                dedupWindow;
+
+        // writer thread only
+        std::vector<Command>    sending;
+        std::string             message;
+
+        std::atomic<unsigned int>   sent;
+        std::atomic<unsigned int>   deduplicated;
+        std::atomic<unsigned int>   dropped;
+
+    };
+
+}
@@ -0,0 +1,2108 @@
+//
+//  ofxMyoWebSocketsConnectionImpl
+//
+//  Definitions for BasicConnection, for connections with policies of your
+//  own. Connection's are only compiled once, in ofxMyoWebSockets.cpp.
+//
+
+#pragma once
+
+#include "ofxMyoWebSockets.h"
+
+namespace ofxMyoWebSockets {
+
+//--------------------------------------------------------------
+template<class Policies>
+BasicConnection<Policies>::BasicConnection(){
+
+    port = 10138;
+    host = 0;
+
+    clock = &Scheduler::getSteadyMicros;
+    realTimeClock = true;
+    reconnectRandom.seed(std::random_device()());
+    updateThreadRunning = false;
+    updatePending = false;
+    updateInterval = 0.1f;
+
+    connected = false;
+    wasConnected = false;
+    listening = false;
+    started = false;
+    configQueued = 0;
+    configApplied = 0;
+    ingestThread = std::thread::id();
+    configChanges.setCapacity(64);
+    reconnect = false;
+    reconnectMinDelay = 0.25f;
+    reconnectMaxDelay = 10.0f;
+    reconnectTime = reconnectMinDelay;
+    reconnectLastAttempt = 0;
+    reconnectAttempts = 0;
+
+    staleTimeout = 3.0f;
+    resyncing = false;
+    staleDeadline = 0;
+
+    featuresEnabled = false;
+    predictionEnabled = false;
+
+    setMaxArmbands(16);
+
+    recorder = NULL;
+    sharedMemory = NULL;
+    oscBridge = NULL;
+
+    messageTime = 0;
+    statsLogInterval = 0;
+    statsLastLog = 0;
+
+    coalesceOrientation = false;
+    droppedEvents = 0;
+    coalescedEvents = 0;
+    nextEvent = 0;
+    eulerIndex = 0;
+    armbandsChanged = false;
+
+    if (dispatch.isQueued()) setQueuedEvents(true);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+BasicConnection<Policies>::~BasicConnection(){
+
+    // before anything update() touches goes away
+    stopUpdateThread();
+
+    // and the socket thread, as the client outlives everything it touches
+    if (listening) client.close();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::connect(bool autoReconnect){
+    connect(hostname, port, autoReconnect);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::connect(string hostname, int port, bool autoReconnect){
+
+    this->hostname = hostname;
+    this->port = port;
+
+    connected = false;
+    reconnect = autoReconnect;
+    reconnectTime = reconnectMinDelay;
+    reconnectAttempts = 0;
+
+    if (!listening) {
+        client.addListener(this);
+        listening = true;
+    }
+
+    // before the socket thread, so it's there for configure()
+    startScheduler();
+
+    openSocket();
+
+    if (!commands.isRunning()) {
+        commands.start([this](const string& message){ client.send(message); });
+    }
+    
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::openSocket(){
+
+    ofxLibwebsockets::ClientOptions options = ofxLibwebsockets::defaultClientOptions();
+    options.host = hostname;
+    options.port = port;
+    options.channel = "/myo/3";
+
+    client.connect(options);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setReconnectDelay(float minimum, float maximum){
+    reconnectMinDelay = minimum;
+    reconnectMaxDelay = MAX(minimum, maximum);
+    reconnectTime = reconnectMinDelay;
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+float BasicConnection<Policies>::getReconnectDelay(){
+
+    float delay = reconnectMinDelay * powf(2.0f, MIN(reconnectAttempts, 16));
+    delay = MIN(delay, reconnectMaxDelay);
+
+    // jitter, so several apps don't all come knocking at the same moment
+    return std::uniform_real_distribution<float>(delay * 0.5f, delay)(reconnectRandom);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setStaleTimeout(float seconds){
+    staleTimeout = seconds;
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setLockingPolicy(string type){
+    lockingPolicy = type;
+    sendCommand("set_locking_policy", type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setRequiresUnlock(bool require){
+    GesturePolicy policy = gestures.getPolicy();
+    policy.requiresUnlock = require;
+    setGesturePolicy(policy);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setUnlockTimeout(float time){
+    GesturePolicy policy = gestures.getPolicy();
+    policy.unlockTimeout = time;
+    setGesturePolicy(policy);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setMinimumGestureDuration(float time){
+    GesturePolicy policy = gestures.getPolicy();
+    policy.minimumGestureDuration = time;
+    setGesturePolicy(policy);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setLockAfterPose(bool lock){
+    GesturePolicy policy = gestures.getPolicy();
+    policy.lockAfterPose = lock;
+    setGesturePolicy(policy);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setGesturePolicy(const GesturePolicy& policy){
+
+    gestures.compile(policy);
+
+    GestureMachine machine = gestures;
+    configure([this, machine]{
+        ingestGestures = machine;
+        applyGesturePolicies();
+    });
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setGesturePolicy(int myoID, const GesturePolicy& policy){
+
+    armbandGestures[myoID].compile(policy);
+
+    GestureMachine machine = armbandGestures[myoID];
+    configure([this, myoID, machine]{
+        ingestArmbandGestures[myoID] = machine;
+        applyGesturePolicies();
+    });
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::clearGesturePolicy(int myoID){
+
+    armbandGestures.erase(myoID);
+
+    configure([this, myoID]{
+        ingestArmbandGestures.erase(myoID);
+        applyGesturePolicies();
+    });
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+const GesturePolicy& BasicConnection<Policies>::getGesturePolicy(int myoID){
+    return getGestures(myoID).getPolicy();
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+const GestureMachine& BasicConnection<Policies>::getGestures(int myoID){
+
+    if (armbandGestures.empty()) return gestures;
+
+    std::map<int, GestureMachine>::const_iterator it = armbandGestures.find(myoID);
+    return it == armbandGestures.end() ? gestures : it->second;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+const GestureMachine& BasicConnection<Policies>::getIngestGestures(int myoID){
+
+    if (ingestArmbandGestures.empty()) return ingestGestures;
+
+    std::map<int, GestureMachine>::const_iterator it = ingestArmbandGestures.find(myoID);
+    return it == ingestArmbandGestures.end() ? ingestGestures : it->second;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::applyGesturePolicies(){
+
+    // nothing to unlock any more
+    for (int i = 0; i < ingestArmbands.size(); i++) {
+        ArmbandState *armband = ingestArmbands[i];
+        if (getIngestGestures(armband->id).getPolicy().requiresUnlock) continue;
+        if (armband->unlocked && armband->unlockDeadline == 0) continue;
+
+        armband->unlocked = true;
+        armband->unlockDeadline = 0;
+        publishArmband(armband);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setUseDegrees(bool degrees){
+    if (!units.setUseDegrees(degrees)) {
+        ofLogWarning("ofxMyoWebSockets") << "Units are fixed by this connection's policies, ignoring setUseDegrees(" << degrees << ")";
+    }
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setHost(int host){
+    this->host = host;
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setQueuedEvents(bool queued, int capacity){
+
+    if (!dispatch.setQueued(queued)) {
+        ofLogWarning("ofxMyoWebSockets") << "Event dispatch is fixed by this connection's policies, ignoring setQueuedEvents(" << queued << ")";
+        return;
+    }
+
+    if (queued) {
+        eventQueue.setCapacity(capacity);
+
+        // reserve up front so draining the queue never allocates
+        pendingEvents.reserve(eventQueue.capacity());
+        eulerBatch.reserve(eventQueue.capacity());
+        supersededEvents.reserve(eventQueue.capacity());
+        coalescedArmbands.reserve(64);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setRecorder(Recorder* recorder){
+    this->recorder = recorder;
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setSharedMemory(SharedMemoryPublisher* publisher){
+
+    configure([this, publisher]{
+        sharedMemory = publisher;
+        for (int i = 0; i < ingestArmbands.size(); i++) {
+            publishSharedMemory(*ingestArmbands[i]);
+        }
+    }, true);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setOscBridge(OscBridge* bridge){
+    configure([this, bridge]{ oscBridge = bridge; }, true);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setCoalesceOrientationEvents(bool coalesce){
+    coalesceOrientation = coalesce;
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setStatsEnabled(bool enabled){
+    stats.setEnabled(enabled);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+Stats BasicConnection<Policies>::getStats(){
+
+    Stats current = stats.getStats(getElapsedTimeMicros());
+    current.droppedEvents = droppedEvents;
+    current.coalescedEvents = coalescedEvents;
+
+    return current;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::resetStats(){
+    stats.reset();
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setStatsLogInterval(float seconds){
+
+    statsLogInterval = seconds;
+    statsLastLog = getElapsedTimef();
+
+    if (seconds > 0) {
+        stats.setEnabled(true);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::update(){
+
+    beginUpdate();
+
+    // Fire anything the socket and scheduler threads have queued up
+    if (dispatch.isQueued()) {
+        collectQueuedEvents();
+        while (peekQueuedEvent()) fireQueuedEvent();
+    }
+
+    endUpdate();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::beginUpdate(){
+
+    // Check if we need to reconnect. Attempts back off from
+    // reconnectMinDelay, so a short blip is over within one round trip but
+    // a Myo Connect that's down for a while isn't hammered.
+    if (connected) {
+        reconnectAttempts = 0;
+        reconnectTime = reconnectMinDelay;
+    }
+    else if (wasConnected) {
+        // just dropped, the first attempt is a delay from now
+        reconnectLastAttempt = getElapsedTimef();
+    }
+    else if (reconnect && getElapsedTimef() - reconnectLastAttempt > reconnectTime) {
+        openSocket();
+        reconnectLastAttempt = getElapsedTimef();
+        reconnectAttempts++;
+        reconnectTime = getReconnectDelay();
+        stats.addReconnectAttempt();
+    }
+
+    if (connected && !wasConnected) {
+        resync();
+    }
+    wasConnected = connected;
+
+    // Pick up whatever the socket thread has published since last frame
+    armbandsChanged = snapshots.consume();
+    if (armbandsChanged) {
+        syncArmbands();
+    }
+
+    // Catch up on deadlines the scheduler's thread hasn't got to yet,
+    // which only happens when the clock isn't real time. Otherwise leave
+    // them to it, so they're never fired from here.
+    if (!realTimeClock) scheduler.poll();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::endUpdate(){
+
+    // Let go of the armbands the socket thread no longer knows about, now
+    // their disconnected events are out
+    if (armbandsChanged) {
+        releaseRemovedArmbands();
+    }
+
+    if (statsLogInterval > 0 && getElapsedTimef() - statsLastLog >= statsLogInterval) {
+        ofLogNotice("ofxMyoWebSockets") << getStats().toString();
+        statsLastLog = getElapsedTimef();
+    }
+
+    // Send off whatever commands this frame (and the socket thread since
+    // last frame) came up with. They wait while the socket's down, so
+    // nothing from before connecting or during a reconnect is lost.
+    if (connected) commands.flush();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setClock(Clock clock){
+
+    // every thread reads it without a lock, so it can't change under them
+    if (isStarted()) {
+        ofLogWarning("ofxMyoWebSockets") << "setClock() has to be called before the connection starts, ignoring it";
+        return;
+    }
+
+    this->clock = clock;
+    realTimeClock = false;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+bool BasicConnection<Policies>::isStarted(){
+    return listening || started || updateThreadRunning;
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::configure(const std::function<void()>& change, bool wait){
+
+    // nothing else is touching the ingest side yet, or we're on the thread
+    // that is
+    if (!(listening || started) || ingestThread.load() == std::this_thread::get_id()) {
+        change();
+        return;
+    }
+
+    if (!configChanges.push(change)) {
+        // backed up, which it never should be with the scheduler about
+        IngestLock lock(*this);
+        change();
+        return;
+    }
+
+    unsigned int queued = ++configQueued;
+    scheduler.schedule(0, DEADLINE_CONFIG, getElapsedTimeMicros());
+
+    // the scheduler's thread gets to it within a millisecond or so
+    while (wait && (int)(configApplied.load(std::memory_order_acquire) - queued) < 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::applyConfigChanges(){
+
+    // only ever one thread at a time in here, under ingestMutex
+    std::function<void()> change;
+    while (configChanges.pop(change)) {
+        change();
+        configApplied.fetch_add(1, std::memory_order_release);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+BasicConnection<Policies>::IngestLock::IngestLock(BasicConnection& connection, bool wait)
+    : connection(connection), lock(connection.ingestMutex, std::defer_lock) {
+
+    if (wait) lock.lock();
+    else if (!lock.try_lock()) return;
+
+    previous = connection.ingestThread.exchange(std::this_thread::get_id());
+
+    // whatever the main thread's changed since, before anything else
+    connection.applyConfigChanges();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+BasicConnection<Policies>::IngestLock::~IngestLock(){
+    if (lock.owns_lock()) connection.ingestThread.store(previous);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::startUpdateThread(float interval){
+
+    if (updateThreadRunning) return;
+
+    updateInterval = MAX(interval, 0.001f);
+    updatePending = false;
+    updateThreadRunning = true;
+    updateThread = std::thread(&BasicConnection::updateThreadFunction, this);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::stopUpdateThread(){
+
+    if (!updateThread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(updateMutex);
+        updateThreadRunning = false;
+    }
+    updateCondition.notify_one();
+    updateThread.join();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::updateThreadFunction(){
+
+    std::chrono::microseconds interval((int64_t)(updateInterval * 1000000));
+
+    while (true) {
+
+        {
+            std::unique_lock<std::mutex> lock(updateMutex);
+            updateCondition.wait_for(lock, interval, [this]{ return updatePending || !updateThreadRunning; });
+            if (!updateThreadRunning) break;
+        }
+
+        // cleared first, so anything arriving during update() wakes us
+        // again straight after
+        updatePending = false;
+        update();
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::wakeUpdateThread(){
+
+    // only the first wake-up since the last update() needs the lock
+    if (!updateThreadRunning || updatePending.exchange(true)) return;
+
+    std::lock_guard<std::mutex> lock(updateMutex);
+    updateCondition.notify_one();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+Armband* BasicConnection<Policies>::getArmband(int myoID){
+
+    Armband* armband = armbandPool.find(myoID);
+    if (armband) return armband;
+
+    // If no armband is found, create and return an empty one
+	return createArmband(myoID);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+Armband* BasicConnection<Policies>::findArmband(int myoID){
+    return armbandPool.find(myoID);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+Armband* BasicConnection<Policies>::getArmband(ArmbandHandle handle){
+    return armbandPool.get(handle);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+ArmbandHandle BasicConnection<Policies>::getArmbandHandle(int myoID){
+    return armbandPool.getHandle(myoID);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+Armband* BasicConnection<Policies>::createArmband(int myoID){
+
+    if (armbandPool.find(myoID)) return armbandPool.find(myoID);
+
+    ArmbandState *armband = armbandPool.acquire(myoID);
+    if (!armband) {
+        ofLogWarning("ofxMyoWebSockets") << "Can't track more than " << armbandPool.capacity() << " armbands, ignoring Myo " << myoID;
+        return NULL;
+    }
+
+    initArmband(armband, myoID, getGestures(myoID).getPolicy().requiresUnlock);
+    armbands.push_back(armband);
+
+    return armband;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setMaxArmbands(int count){
+
+    // the pools can't be reallocated from under the armbands in them
+    if (isStarted()) {
+        ofLogWarning("ofxMyoWebSockets") << "setMaxArmbands() has to be called before the connection starts, ignoring it";
+        return;
+    }
+
+    armbandPool.setCapacity(count);
+    ingestArmbands.setCapacity(count);
+    ingestVersions.assign(count, 0);
+    stats.setMaxArmbands(count);
+    poseHistories.assign(count, PoseHistory());
+
+    // same windows as before
+    FeatureExtractor features = featureExtractors.empty() ? FeatureExtractor() : featureExtractors[0];
+    featureExtractors.assign(count, features);
+
+    OrientationPredictor predictor = predictors.empty() ? OrientationPredictor() : predictors[0];
+    predictors.assign(count, predictor);
+
+    armbands.clear();
+    armbands.reserve(count);
+
+    eulerBatch.reserve(MAX(count, eventQueue.capacity()));
+    eulerArmbands.reserve(count);
+
+    // one sample history per armband slot, handed out as armbands appear
+    int samples = imuHistories.empty() ? 256 : imuHistories[0].getCapacity();
+    vector<ImuHistory>(count).swap(imuHistories);
+    setImuHistorySize(samples);
+
+    // and EMG, whether it's streamed or not
+    samples = emgHistories.empty() ? 1024 : emgHistories[0].getCapacity();
+    vector<EmgHistory>(count).swap(emgHistories);
+    setEmgHistorySize(samples);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setImuHistorySize(int samples){
+
+    // armbands on the socket thread, and readers on this one, hold on to
+    // the histories
+    if (isStarted()) {
+        ofLogWarning("ofxMyoWebSockets") << "setImuHistorySize() has to be called before the connection starts, ignoring it";
+        return;
+    }
+
+    freeImuHistories.clear();
+
+    for (int i = 0; i < imuHistories.size(); i++) {
+        imuHistories[i].setCapacity(samples);
+        freeImuHistories.push_back(&imuHistories[i]);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setEmgHistorySize(int samples){
+
+    if (isStarted()) {
+        ofLogWarning("ofxMyoWebSockets") << "setEmgHistorySize() has to be called before the connection starts, ignoring it";
+        return;
+    }
+
+    freeEmgHistories.clear();
+
+    for (int i = 0; i < emgHistories.size(); i++) {
+        emgHistories[i].setCapacity(samples);
+        freeEmgHistories.push_back(&emgHistories[i]);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setFeaturesEnabled(bool enabled){
+
+    configure([this, enabled]{
+
+        // start from scratch rather than from whatever came in before
+        if (enabled && !featuresEnabled) {
+            for (int i = 0; i < featureExtractors.size(); i++) {
+                featureExtractors[i].clear();
+            }
+        }
+
+        featuresEnabled = enabled;
+
+    });
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setFeatureWindows(int emgSamples, int imuSamples){
+
+    configure([this, emgSamples, imuSamples]{
+        for (int i = 0; i < featureExtractors.size(); i++) {
+            featureExtractors[i].setWindows(emgSamples, imuSamples);
+        }
+    });
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setPredictionEnabled(bool enabled){
+
+    configure([this, enabled]{
+
+        if (enabled && !predictionEnabled) {
+            for (int i = 0; i < predictors.size(); i++) {
+                predictors[i].clear();
+            }
+        }
+
+        predictionEnabled = enabled;
+
+    });
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setPredictionFilter(float minCutoff, float beta){
+
+    configure([this, minCutoff, beta]{
+        for (int i = 0; i < predictors.size(); i++) {
+            predictors[i].setFilter(minCutoff, beta);
+        }
+    });
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setMaxPrediction(float seconds){
+
+    configure([this, seconds]{
+        for (int i = 0; i < predictors.size(); i++) {
+            predictors[i].setMaxPrediction(seconds);
+        }
+    });
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setStreamEmg(int myoID, bool enabled){
+
+    // remembered for when it reconnects
+    configure([this, myoID, enabled]{
+        vector<int>::iterator it = find(emgStreaming.begin(), emgStreaming.end(), myoID);
+        if (enabled && it == emgStreaming.end()) emgStreaming.push_back(myoID);
+        if (!enabled && it != emgStreaming.end()) emgStreaming.erase(it);
+    });
+
+    sendCommand(myoID, "set_stream_emg", enabled ? "enabled" : "disabled");
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setStreamEmg(Armband* armband, bool enabled){
+    setStreamEmg(armband->id, enabled);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::initArmband(ArmbandState* armband, int myoID, bool requiresUnlock){
+
+    armband->id = myoID;
+    armband->host = host;
+    armband->rssi = -999;
+    armband->timestamp = 0;
+    armband->stale = false;
+
+    armband->arm = ARM_UNKNOWN;
+    armband->direction = X_DIRECTION_UNKNOWN;
+    armband->pose = POSE_UNKNOWN;
+    armband->lastPose = POSE_UNKNOWN;
+
+    armband->quat = ofQuaternion(0, 0, 0, 1);
+    armband->history = NULL;
+    armband->emgHistory = NULL;
+    armband->features = Features();
+    armband->motion = Motion();
+    armband->roll = 0;
+    armband->pitch = 0;
+    armband->yaw = 0;
+
+    // nothing derived yet
+    armband->orientationGeneration = 1;
+    armband->useDegrees = units.useDegrees();
+    armband->derived.eulerDegrees = false;
+    armband->derived.eulerGeneration = 0;
+    armband->derived.rotationGeneration = 0;
+    armband->derived.linearAccelGeneration = 0;
+    armband->derived.worldGyroGeneration = 0;
+
+    armband->poseStartTime = 0;
+    armband->poseConfirmed = false;
+    armband->unlocked = !Policies::Locking::enabled || !requiresUnlock;
+    armband->unlockStartTime = 0;
+    armband->sequence = -1;
+
+    armband->poseDeadline = 0;
+    armband->unlockDeadline = 0;
+    armband->slot = -1;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+ArmbandState* BasicConnection<Policies>::getIngestArmband(int myoID){
+
+    ArmbandState *armband = ingestArmbands.find(myoID);
+    if (armband) {
+        armband->stale = false;
+        return armband;
+    }
+
+    armband = ingestArmbands.acquire(myoID);
+    if (!armband) return NULL;
+
+    initArmband(armband, myoID, getIngestGestures(myoID).getPolicy().requiresUnlock);
+
+    armband->slot = ingestArmbands.getHandle(myoID).slot;
+    ingestVersions[armband->slot]++;
+    stats.resetArmband(armband->slot, myoID);
+    poseHistories[armband->slot].clear();
+    featureExtractors[armband->slot].clear();
+    predictors[armband->slot].clear();
+
+    if (!freeImuHistories.empty()) {
+        armband->history = freeImuHistories.back();
+        armband->history->clear();
+        freeImuHistories.pop_back();
+    }
+
+    if (!freeEmgHistories.empty()) {
+        armband->emgHistory = freeEmgHistories.back();
+        armband->emgHistory->clear();
+        freeEmgHistories.pop_back();
+    }
+
+    return armband;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::removeIngestArmband(int myoID){
+
+    ArmbandState *armband = ingestArmbands.find(myoID);
+    if (!armband) return;
+
+    if (armband->history) freeImuHistories.push_back(armband->history);
+    if (armband->emgHistory) freeEmgHistories.push_back(armband->emgHistory);
+    if (sharedMemory) sharedMemory->removeArmband(armband->slot);
+    stats.resetArmband(armband->slot, -1);
+    ingestArmbands.release(myoID);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::expireStaleArmbands(){
+
+    if (getElapsedTimeMicros() < staleDeadline) return;
+    resyncing = false;
+
+    bool removed = false;
+
+    for (int i = ingestArmbands.size() - 1; i >= 0; i--) {
+        ArmbandState *armband = ingestArmbands[i];
+        if (!armband->stale) continue;
+
+        notify(QueuedEvent::DISCONNECTED, armband);
+        removeIngestArmband(armband->id);
+        removed = true;
+    }
+
+    if (removed) publishSnapshot();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::resync(){
+
+    // Myo Connect forgets our settings along with the connection, and the
+    // signal strength we have is from before the drop
+    if (!lockingPolicy.empty()) {
+        sendCommand("set_locking_policy", lockingPolicy);
+    }
+
+    for (int i = 0; i < armbands.size(); i++) {
+        requestSignalStrength(armbands[i]);
+    }
+
+    // EMG streaming is turned back on by onOpen()
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::publishArmband(ArmbandState* armband){
+
+    ingestVersions[armband->slot]++;
+    publishSharedMemory(*armband);
+    publishSnapshot();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::publishArmbands(){
+
+    for (int i = 0; i < ingestArmbands.size(); i++) {
+        ingestVersions[ingestArmbands[i]->slot]++;
+        publishSharedMemory(*ingestArmbands[i]);
+    }
+
+    publishSnapshot();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::publishSnapshot(){
+
+    // Bring the back buffer up to date and hand it over. It's two
+    // publishes behind, so usually that's copying the armband the last
+    // couple of messages were about, and never allocates once it's sized.
+    Snapshot& snapshot = snapshots.back();
+
+    if (snapshot.armbands.size() != ingestVersions.size()) {
+        snapshot.armbands.assign(ingestVersions.size(), ArmbandState());
+        snapshot.versions.assign(ingestVersions.size(), 0);
+        snapshot.slots.reserve(ingestVersions.size());
+    }
+
+    snapshot.slots.clear();
+
+    for (int i = 0; i < ingestArmbands.size(); i++) {
+
+        int slot = ingestArmbands[i]->slot;
+        snapshot.slots.push_back(slot);
+
+        if (snapshot.versions[slot] == ingestVersions[slot]) continue;
+
+        snapshot.armbands[slot] = *ingestArmbands[i];
+        snapshot.versions[slot] = ingestVersions[slot];
+
+        // features are only worked out from the running sums when they're
+        // handed over
+        if (featuresEnabled) {
+            featureExtractors[slot].getFeatures(snapshot.armbands[slot].features);
+        }
+    }
+
+    snapshots.publish();
+    wakeUpdateThread();
+
+    publishOsc();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::publishOsc(){
+
+    if (!oscBridge) return;
+
+    // poses & locking since the last message, plus every armband's
+    // orientation when it's due, in one bundle
+    uint64_t now = getElapsedTimeMicros();
+    if (!oscBridge->isDue(now)) return;
+
+    for (int i = 0; i < ingestArmbands.size(); i++) {
+        oscBridge->addOrientation(*ingestArmbands[i]);
+    }
+
+    oscBridge->send(now);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::publishSharedMemory(const ArmbandState& armband){
+
+    if (!sharedMemory) return;
+
+    SharedArmbandState state;
+    state.id = armband.id;
+    state.host = armband.host;
+    state.rssi = armband.rssi;
+    state.arm = armband.arm;
+    state.direction = armband.direction;
+    state.pose = armband.pose;
+    state.lastPose = armband.lastPose;
+    state.stale = armband.stale;
+    state.unlocked = armband.unlocked;
+    state.poseConfirmed = armband.poseConfirmed;
+    state.timestamp = armband.timestamp;
+
+    state.accel[0] = armband.accel.x;
+    state.accel[1] = armband.accel.y;
+    state.accel[2] = armband.accel.z;
+    state.gyro[0] = armband.gyro.x;
+    state.gyro[1] = armband.gyro.y;
+    state.gyro[2] = armband.gyro.z;
+    state.quat[0] = armband.quat.x();
+    state.quat[1] = armband.quat.y();
+    state.quat[2] = armband.quat.z();
+    state.quat[3] = armband.quat.w();
+
+    sharedMemory->setArmband(armband.slot, state);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::syncArmbands(){
+
+    const Snapshot& snapshot = snapshots.front();
+
+    eulerBatch.clear();
+    eulerArmbands.clear();
+
+    for (int i = 0; i < snapshot.slots.size(); i++) {
+
+        const ArmbandState& latest = snapshot.armbands[snapshot.slots[i]];
+        ArmbandState* armband = armbandPool.find(latest.id);
+        if (!armband) armband = static_cast<ArmbandState*>(createArmband(latest.id));
+        if (!armband) continue;
+
+        // Sensor data always comes straight from the socket thread
+        armband->rssi = latest.rssi;
+        armband->timestamp = latest.timestamp;
+        armband->stale = latest.stale;
+        armband->arm = latest.arm;
+        armband->direction = latest.direction;
+        armband->accel = latest.accel;
+        armband->gyro = latest.gyro;
+        armband->quat = latest.quat;
+        armband->history = latest.history;
+        armband->emgHistory = latest.emgHistory;
+        armband->features = latest.features;
+        armband->motion = latest.motion;
+        armband->orientationGeneration++;
+        armband->useDegrees = units.useDegrees();
+
+        if (Policies::Derived::eager) {
+            eulerBatch.add(latest.quat.x(), latest.quat.y(), latest.quat.z(), latest.quat.w());
+            eulerArmbands.push_back(armband);
+        }
+
+        // So do pose confirmation and locking, which run to the scheduler's
+        // deadlines rather than the frame rate
+        armband->pose = latest.pose;
+        armband->lastPose = latest.lastPose;
+        armband->poseStartTime = latest.poseStartTime;
+        armband->poseConfirmed = latest.poseConfirmed;
+        armband->unlocked = latest.unlocked;
+        armband->unlockStartTime = latest.unlockStartTime;
+        armband->sequence = latest.sequence;
+    }
+
+    // Euler angles for every armband in one go
+    if (Policies::Derived::eager) eulerBatch.convert();
+
+    for (int i = 0; i < eulerArmbands.size(); i++) {
+        setEulerAngles(eulerArmbands[i], eulerBatch.roll[i], eulerBatch.pitch[i], eulerBatch.yaw[i]);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::releaseRemovedArmbands(){
+
+    const Snapshot& snapshot = snapshots.front();
+
+    // Drop armbands which the socket thread no longer knows about
+    for (int i = armbands.size() - 1; i >= 0; i--) {
+
+        bool found = false;
+        for (int j = 0; j < snapshot.slots.size(); j++) {
+            if (snapshot.armbands[snapshot.slots[j]].id == armbands[i]->id) {
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            armbandPool.release(armbands[i]->id);
+            armbands.erase(armbands.begin() + i);
+        }
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::notify(QueuedEvent::Type type, Armband* armband){
+
+    // goes out with the next bundle, listeners or not
+    if (oscBridge) {
+        switch (type) {
+            case QueuedEvent::POSE_STARTED:     oscBridge->addPose(*armband, false); break;
+            case QueuedEvent::POSE_CONFIRMED:   oscBridge->addPose(*armband, true); break;
+            case QueuedEvent::UNLOCKED:
+            case QueuedEvent::LOCKED:           oscBridge->addUnlocked(*armband); break;
+            default:                            break;
+        }
+    }
+
+    // nobody's listening
+    if (getEvent(type).size() == 0) return;
+
+    // Straight from whichever thread got here, the socket's or the
+    // scheduler's. Both hold ingestMutex, so listeners are never called
+    // from both at once.
+    if (!dispatch.isQueued()) {
+
+        // update() hasn't been yet, so roll, pitch & yaw are filled in
+        // here, once per orientation sample
+        if (Policies::Derived::eager) {
+            const ofVec3f& euler = armband->getEulerAngles();
+            armband->roll = euler.x;
+            armband->pitch = euler.y;
+            armband->yaw = euler.z;
+        }
+
+        ofNotifyEvent(getEvent(type), *armband, this);
+        if (stats.isEnabled()) stats.addDispatchLatency(getElapsedTimeMicros() - messageTime);
+        return;
+    }
+
+    QueuedEvent event;
+    event.type = type;
+    event.myo = armband->id;
+    event.received = messageTime;
+
+    event.rssi = armband->rssi;
+    event.accel[0] = armband->accel.x;
+    event.accel[1] = armband->accel.y;
+    event.accel[2] = armband->accel.z;
+    event.gyro[0] = armband->gyro.x;
+    event.gyro[1] = armband->gyro.y;
+    event.gyro[2] = armband->gyro.z;
+    event.quat[0] = armband->quat.x();
+    event.quat[1] = armband->quat.y();
+    event.quat[2] = armband->quat.z();
+    event.quat[3] = armband->quat.w();
+
+    event.pose = armband->pose;
+    event.lastPose = armband->lastPose;
+    event.unlocked = armband->unlocked;
+    event.poseConfirmed = armband->poseConfirmed;
+    event.sequence = armband->sequence;
+
+    // one producer at a time, again thanks to ingestMutex
+    if (!eventQueue.push(event)) {
+        droppedEvents++;
+    }
+
+    wakeUpdateThread();
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+ofEvent<Armband>& BasicConnection<Policies>::getEvent(QueuedEvent::Type type){
+
+    switch (type) {
+        case QueuedEvent::PAIRED:           return pairedEvent;
+        case QueuedEvent::UNPAIRED:         return unpairedEvent;
+        case QueuedEvent::CONNECTED:        return connectedEvent;
+        case QueuedEvent::DISCONNECTED:     return disconnectedEvent;
+        case QueuedEvent::ARM_RECOGNIZED:   return armRecognizedEvent;
+        case QueuedEvent::ARM_LOST:         return armLostEvent;
+        case QueuedEvent::ARM_SYNCED:       return armSyncedEvent;
+        case QueuedEvent::ARM_UNSYNCED:     return armUnsyncedEvent;
+        case QueuedEvent::UNLOCKED:         return unlockedEvent;
+        case QueuedEvent::LOCKED:           return lockedEvent;
+        case QueuedEvent::POSE_STARTED:     return poseStartedEvent;
+        case QueuedEvent::POSE_CONFIRMED:   return poseConfirmedEvent;
+        case QueuedEvent::POSE_SEQUENCE:    return poseSequenceEvent;
+        case QueuedEvent::ORIENTATION:      return orientationEvent;
+        case QueuedEvent::RSSI_RECEIVED:    return rssiReceivedEvent;
+    }
+
+    return orientationEvent;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::collectQueuedEvents(){
+
+    // Only take what's there right now, so a busy socket can't keep us
+    // in here forever
+    pendingEvents.clear();
+    nextEvent = 0;
+
+    QueuedEvent event;
+    while (pendingEvents.size() < pendingEvents.capacity() && eventQueue.pop(event)) {
+        pendingEvents.push_back(event);
+    }
+
+    // Walk backwards and mark every orientation event which has a newer one
+    // for the same armband later on in this batch
+    supersededEvents.assign(pendingEvents.size(), 0);
+
+    if (coalesceOrientation) {
+
+        coalescedArmbands.clear();
+
+        for (int i = pendingEvents.size() - 1; i >= 0; i--) {
+
+            if (pendingEvents[i].type != QueuedEvent::ORIENTATION) continue;
+
+            int myo = pendingEvents[i].myo;
+            if (find(coalescedArmbands.begin(), coalescedArmbands.end(), myo) != coalescedArmbands.end()) {
+                supersededEvents[i] = 1;
+                coalescedEvents++;
+            } else {
+                coalescedArmbands.push_back(myo);
+            }
+        }
+    }
+
+    // Euler angles for every orientation event we're about to fire, in one
+    // go. eulerIndex is the position of the next one in the batch.
+    eulerBatch.clear();
+
+    for (int i = 0; i < pendingEvents.size() && Policies::Derived::eager; i++) {
+        const QueuedEvent& event = pendingEvents[i];
+        if (supersededEvents[i] || event.type != QueuedEvent::ORIENTATION) continue;
+        eulerBatch.add(event.quat[0], event.quat[1], event.quat[2], event.quat[3]);
+    }
+
+    eulerBatch.convert();
+    eulerIndex = 0;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+const QueuedEvent* BasicConnection<Policies>::peekQueuedEvent(){
+
+    while (nextEvent < pendingEvents.size() && supersededEvents[nextEvent]) {
+        nextEvent++;
+    }
+
+    return nextEvent < pendingEvents.size() ? &pendingEvents[nextEvent] : NULL;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::fireQueuedEvent(){
+
+    if (!peekQueuedEvent()) return;
+
+    const QueuedEvent& event = pendingEvents[nextEvent++];
+
+    // its place in the Euler batch, fired or not
+    int euler = eulerIndex;
+    if (Policies::Derived::eager && event.type == QueuedEvent::ORIENTATION) eulerIndex++;
+
+    Armband* armband = getArmband(event.myo);
+    if (!armband) return;
+
+    // Bring the armband up to the time of the event, since it may have
+    // arrived after the snapshot we synced with
+    if (event.type == QueuedEvent::ORIENTATION) {
+        armband->accel.set(event.accel[0], event.accel[1], event.accel[2]);
+        armband->gyro.set(event.gyro[0], event.gyro[1], event.gyro[2]);
+        armband->quat.set(event.quat[0], event.quat[1], event.quat[2], event.quat[3]);
+        armband->orientationGeneration++;
+
+        if (Policies::Derived::eager) {
+            setEulerAngles(armband, eulerBatch.roll[euler], eulerBatch.pitch[euler], eulerBatch.yaw[euler]);
+        }
+    }
+
+    if (event.type == QueuedEvent::RSSI_RECEIVED) {
+        armband->rssi = event.rssi;
+    }
+
+    armband->pose = event.pose;
+    armband->lastPose = event.lastPose;
+    armband->unlocked = event.unlocked;
+    armband->poseConfirmed = event.poseConfirmed;
+    armband->sequence = event.sequence;
+
+    ofNotifyEvent(getEvent(event.type), *armband, this);
+    if (stats.isEnabled()) stats.addDispatchLatency(getElapsedTimeMicros() - event.received);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+int BasicConnection<Policies>::numConnectedArmbands(){
+    return armbands.size();
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setCommandDedupWindow(float seconds){
+    commands.setDedupWindow(seconds * 1000000);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::sendCommand(string command, string type){
+    sendCommand(-1, command, type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::sendCommand(int myoID, string command){
+    sendCommand(myoID, command, "");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::sendCommand(int myoID, string command, string type){
+    commands.push(myoID, command, type, getElapsedTimeMicros());
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::sendCommand(Armband* armband, string command){
+    sendCommand(armband, command, "");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::sendCommand(Armband* armband, string command, string type){
+    sendCommand(armband->id, command, type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::notifyUserAction(int myoID, string type){
+    sendCommand(myoID, "notify_user_action", type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::notifyUserAction(Armband* armband, string type){
+    sendCommand(armband->id, "notify_user_action", type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::vibrate(int myoID, string type){
+    sendCommand(myoID, "vibrate", type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::vibrate(Armband* armband, string type){
+    sendCommand(armband->id, "vibrate", type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::requestSignalStrength(int myoID){
+    sendCommand(myoID, "request_rssi");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::requestSignalStrength(Armband* armband	){
+    sendCommand(armband->id, "request_rssi");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::lock(int myoID){
+    sendCommand(myoID, "lock");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::lock(Armband* armband){
+    sendCommand(armband->id, "lock");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::unlock(int myoID, string type){
+    sendCommand(myoID, "unlock", type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::unlock(Armband* armband, string type){
+    sendCommand(armband->id, "unlock", type);
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::processMessage(const string& message){
+
+    // with no socket, this is where the connection starts
+    started.store(true, std::memory_order_relaxed);
+
+    uint64_t timestamp = getElapsedTimeMicros();
+    handleMessage(message, NULL, timestamp);
+
+    if (stats.isEnabled()) stats.addHandleTime(getElapsedTimeMicros() - timestamp);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::onMessage( ofxLibwebsockets::Event& args ){
+
+    uint64_t timestamp = getElapsedTimeMicros();
+
+    Recorder* recorder = this->recorder.load();
+    if (recorder) {
+        recorder->record(args.message.data(), args.message.size(), timestamp);
+    }
+
+    handleMessage(args.message, &args.json, timestamp);
+
+    if (stats.isEnabled()) stats.addHandleTime(getElapsedTimeMicros() - timestamp);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::handleMessage(const string& message, const Json::Value* json, uint64_t timestamp){
+
+    // Orientation data makes up nearly all of the traffic, so decode it
+    // straight from the raw message and skip the JSON tree entirely
+    IngestLock lock(*this);
+
+    // anything that came due while the scheduler's thread couldn't get in,
+    // starting it first for processMessage()
+    startScheduler();
+    scheduler.poll();
+
+    messageTime = timestamp;
+
+    if (resyncing) expireStaleArmbands();
+
+    OrientationFrame frame;
+    if (parseOrientation(message.data(), message.size(), frame)) {
+        ArmbandState *armband = getIngestArmband(frame.myo);
+        if (armband) {
+            stats.addMessage(armband->slot, true);
+            onOrientation(armband, frame, timestamp);
+            publishArmband(armband);
+        }
+        return;
+    }
+
+    // EMG comes in four times as fast, but it only goes into the armband's
+    // sample history (and features). There's no event for it, and nothing
+    // else for the main thread to pick up unless the armband is new or back
+    // from being stale.
+    EmgFrame emg;
+    if (parseEmg(message.data(), message.size(), emg)) {
+        ArmbandState *armband = ingestArmbands.find(emg.myo);
+        bool changed = !armband || armband->stale;
+
+        armband = getIngestArmband(emg.myo);
+        if (armband) {
+            stats.addMessage(armband->slot, true);
+            onEmg(armband, emg, timestamp);
+            if (changed || featuresEnabled) publishArmband(armband);
+        }
+        return;
+    }
+
+    try {
+
+        // ofxLibwebsockets has already parsed messages from the socket,
+        // anything else (e.g. a recording) still needs parsing
+        ofxJSONElement parsed;
+        if (!json) {
+            if (!parsed.parse(message)) return;
+            json = &parsed;
+        }
+
+        ofxJSONElement data = (*json)[1];
+        if (data.isNull()) return;
+
+        int id = data["myo"].asInt();
+        EventType event = parseEventType(data["type"].asString());
+
+        // e.g. acknowledgements of our own commands
+        if (event == EVENT_UNKNOWN) return;
+
+        ArmbandState *state = getIngestArmband(id);
+        Armband *armband = state;
+
+        // out of room, createArmband() on the main thread will complain
+        if (!armband) return;
+
+        stats.addMessage(state->slot, false);
+
+        const Json::Value& sentTime = data["timestamp"];
+        if (sentTime.isString()) {
+            string value = sentTime.asString();
+            armband->timestamp = parseTimestamp(value.data(), value.size());
+        }
+
+        switch (event) {
+
+            //
+            // PAIRED
+            //
+            case EVENT_PAIRED:
+                notify(QueuedEvent::PAIRED, armband);
+                break;
+
+            //
+            // UNPAIRED
+            //
+            case EVENT_UNPAIRED:
+                notify(QueuedEvent::UNPAIRED, armband);
+                removeIngestArmband(id);
+                break;
+
+            //
+            // CONNECTED
+            //
+            case EVENT_CONNECTED:
+                requestSignalStrength(armband);
+
+                // as does turning EMG streaming on
+                if (find(emgStreaming.begin(), emgStreaming.end(), id) != emgStreaming.end()) {
+                    sendCommand(id, "set_stream_emg", "enabled");
+                }
+                notify(QueuedEvent::CONNECTED, armband);
+                break;
+
+            //
+            // DISCONNECTED
+            //
+            case EVENT_DISCONNECTED:
+                notify(QueuedEvent::DISCONNECTED, armband);
+                removeIngestArmband(id);
+                break;
+
+            //
+            // ARM RECOGNIZED (API v1) / ARM SYNCED (API v2)
+            //
+            case EVENT_ARM_RECOGNIZED:
+            case EVENT_ARM_SYNCED:
+
+                armband->arm = parseArm(data["arm"].asString());
+                armband->direction = parseXDirection(data["x_direction"].asString());
+                armband->orientationGeneration++;
+
+                // v1 listeners still get notified for v2 events
+                notify(QueuedEvent::ARM_RECOGNIZED, armband);
+                if (event == EVENT_ARM_SYNCED) notify(QueuedEvent::ARM_SYNCED, armband);
+                break;
+
+            //
+            // ARM LOST (API v1) / ARM UNSYNCED (API v2)
+            //
+            case EVENT_ARM_LOST:
+            case EVENT_ARM_UNSYNCED:
+
+                armband->arm = ARM_UNKNOWN;
+                armband->direction = X_DIRECTION_UNKNOWN;
+                armband->orientationGeneration++;
+
+                notify(QueuedEvent::ARM_LOST, armband);
+                if (event == EVENT_ARM_UNSYNCED) notify(QueuedEvent::ARM_UNSYNCED, armband);
+                break;
+
+            //
+            // ORIENTATION
+            //
+            case EVENT_ORIENTATION: {
+
+                OrientationFrame frame;
+                frame.myo = id;
+                frame.timestamp = armband->timestamp;
+
+                // accelerometer data
+                ofxJSONElement accelerometer = data["accelerometer"];
+
+                frame.accel[0] = accelerometer[0].asFloat();
+                frame.accel[1] = accelerometer[1].asFloat();
+                frame.accel[2] = accelerometer[2].asFloat();
+
+                // gyroscope data
+                ofxJSONElement gyroscope = data["gyroscope"];
+
+                frame.gyro[0] = gyroscope[0].asFloat();
+                frame.gyro[1] = gyroscope[1].asFloat();
+                frame.gyro[2] = gyroscope[2].asFloat();
+
+                // quaternion data
+                ofxJSONElement quat = data["orientation"];
+
+                frame.quat[0] = quat["x"].asFloat();
+                frame.quat[1] = quat["y"].asFloat();
+                frame.quat[2] = quat["z"].asFloat();
+                frame.quat[3] = quat["w"].asFloat();
+
+                onOrientation(state, frame, timestamp);
+                break;
+            }
+
+            //
+            // EMG
+            //
+            case EVENT_EMG: {
+
+                EmgFrame frame;
+                frame.myo = id;
+                frame.timestamp = armband->timestamp;
+
+                ofxJSONElement emg = data["emg"];
+
+                for (int i = 0; i < emgChannels; i++) {
+                    frame.emg[i] = ofClamp(emg[i].asInt(), -128, 127);
+                }
+
+                onEmg(state, frame, timestamp);
+                break;
+            }
+
+            //
+            // UNLOCK
+            //
+            case EVENT_UNLOCKED:
+
+                // straight from Myo Connect, if there's no state machine
+                if (!Policies::Locking::enabled) {
+                    armband->unlocked = true;
+                    notify(QueuedEvent::UNLOCKED, armband);
+                    break;
+                }
+
+                unlockArmband(state);
+                break;
+
+            //
+            // LOCK
+            //
+            case EVENT_LOCKED:
+
+                if (!Policies::Locking::enabled) {
+                    armband->unlocked = false;
+                    notify(QueuedEvent::LOCKED, armband);
+                    break;
+                }
+
+                lockArmband(state);
+                notify(QueuedEvent::LOCKED, armband);
+
+                // there's no such thing as locked if unlocking isn't required
+                if (!getIngestGestures(id).getPolicy().requiresUnlock) armband->unlocked = true;
+                break;
+
+            //
+            // POSE
+            //
+            case EVENT_POSE: {
+
+                Pose pose = parsePose(data["pose"].asString());
+
+                armband->lastPose = armband->pose;
+
+                armband->pose = pose;
+                armband->poseConfirmed = false;
+                armband->poseStartTime = getElapsedTimef();
+                state->poseDeadline = 0;
+
+                notify(QueuedEvent::POSE_STARTED, armband);
+
+                // every pose counts right away, if there's no state machine
+                if (!Policies::Locking::enabled) {
+                    armband->poseConfirmed = true;
+                    notify(QueuedEvent::POSE_CONFIRMED, armband);
+                    break;
+                }
+
+                runGestureActions(state, GestureMachine::STARTED);
+
+                // then see if it finishes off a sequence
+                PoseHistory& poses = poseHistories[state->slot];
+                poses.push(pose, timestamp);
+
+                // likewise copied before notify()
+                const GestureMachine& machine = getIngestGestures(id);
+                int sequence = machine.matchSequence(poses);
+                bool unlocks = sequence >= 0 && machine.getPolicy().sequences[sequence].unlocks;
+
+                if (sequence >= 0) {
+                    armband->sequence = sequence;
+                    poses.clear();
+                    notify(QueuedEvent::POSE_SEQUENCE, armband);
+
+                    if (unlocks && !armband->unlocked) {
+                        vibrate(armband, "short");
+                        notifyUserAction(armband, "single");
+                        unlockArmband(state);
+                    }
+                }
+                break;
+            }
+
+            //
+            // RSSI
+            //
+            case EVENT_RSSI:
+                armband->rssi = data["rssi"].asInt();
+                stats.addRssi(state->slot, timestamp);
+                notify(QueuedEvent::RSSI_RECEIVED, armband);
+                break;
+
+            default:
+                break;
+        }
+
+        // unless it's just gone
+        if (ingestArmbands.find(id)) publishArmband(state);
+        else publishSnapshot();
+        
+    }
+    catch(exception& e){
+        ofLogError() << e.what();
+    }
+    
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::onOrientation(ArmbandState* armband, const OrientationFrame& frame, uint64_t timestamp){
+
+    armband->timestamp = frame.timestamp;
+    stats.addOrientation(armband->slot, frame.timestamp, timestamp);
+
+    if (armband->history) {
+        armband->history->push(timestamp, frame.accel, frame.gyro, frame.quat);
+    }
+
+    if (featuresEnabled) {
+        featureExtractors[armband->slot].addImu(frame.accel, frame.gyro);
+    }
+
+    if (sharedMemory) {
+        sharedMemory->addSample(armband->slot, timestamp, frame.accel, frame.gyro, frame.quat);
+    }
+
+    if (predictionEnabled) {
+        OrientationPredictor& predictor = predictors[armband->slot];
+        predictor.add(frame.timestamp, timestamp, frame.quat, frame.gyro);
+        armband->motion = predictor.getMotion();
+    }
+
+    // store accelerometer & gyroscope data
+    armband->accel.set(frame.accel[0], frame.accel[1], frame.accel[2]);
+    armband->gyro.set(frame.gyro[0], frame.gyro[1], frame.gyro[2]);
+
+    // store quaternion data
+    armband->quat.set(frame.quat[0], frame.quat[1], frame.quat[2], frame.quat[3]);
+
+    // Nothing is derived here. Roll, pitch & yaw are worked out for all
+    // armbands at once in update(), and listeners on this thread get them
+    // (or anything else) on demand from the accessors.
+    armband->orientationGeneration++;
+    armband->useDegrees = units.useDegrees();
+
+    notify(QueuedEvent::ORIENTATION, armband);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::onEmg(ArmbandState* armband, const EmgFrame& frame, uint64_t timestamp){
+
+    armband->timestamp = frame.timestamp;
+
+    if (armband->emgHistory) {
+        armband->emgHistory->push(timestamp, frame.emg);
+    }
+
+    if (featuresEnabled) {
+        featureExtractors[armband->slot].addEmg(frame.emg);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::startScheduler(){
+
+    if (!scheduler.isRunning()) {
+        scheduler.start([this](int myoID, int kind, uint64_t deadline){ return onDeadline(myoID, kind, deadline); },
+                        [this]{ return clock(); });
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::scheduleDeadline(ArmbandState* armband, Deadline kind, float seconds){
+
+    startScheduler();
+
+    uint64_t deadline = getElapsedTimeMicros() + (uint64_t)(MAX(seconds, 0.0f) * 1000000);
+
+    if (kind == DEADLINE_POSE) armband->poseDeadline = deadline;
+    else armband->unlockDeadline = deadline;
+
+    scheduler.schedule(armband->id, kind, deadline);
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+bool BasicConnection<Policies>::onDeadline(int myoID, int kind, uint64_t deadline){
+
+    // Never wait on the socket thread: if it's busy with a message, it
+    // polls the scheduler before the next one, or we try again shortly
+    IngestLock lock(*this, false);
+    if (!lock.ownsLock()) return false;
+
+    // the lock's applied them
+    if (kind == DEADLINE_CONFIG) return true;
+
+    // so stats measure dispatch latency from the deadline
+    messageTime = deadline;
+
+    // reconnected again since, or every armband came back already
+    if (kind == DEADLINE_STALE) {
+        if (resyncing && deadline == staleDeadline) expireStaleArmbands();
+        return true;
+    }
+
+    ArmbandState *armband = ingestArmbands.find(myoID);
+
+    // the pose changed, or it was unlocked again (or locked), in the
+    // meantime
+    if (!armband ||
+        (kind == DEADLINE_POSE && armband->poseDeadline != deadline) ||
+        (kind == DEADLINE_UNLOCK && armband->unlockDeadline != deadline)) {
+        return true;
+    }
+
+    if (kind == DEADLINE_POSE) {
+
+        armband->poseDeadline = 0;
+        runGestureActions(armband, GestureMachine::HELD);
+
+    } else {
+
+        armband->unlockDeadline = 0;
+
+        if (getIngestGestures(myoID).getPolicy().requiresUnlock && armband->unlocked) {
+            lockArmband(armband);
+            notifyUserAction(armband, "single");
+            notify(QueuedEvent::LOCKED, armband);
+        }
+    }
+
+    publishArmband(armband);
+
+    return true;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::runGestureActions(ArmbandState* armband, GestureMachine::Trigger trigger){
+
+    // Everything we need from the policy, copied before any notify():
+    // listeners on this thread are free to change or clear policies, which
+    // may free the machine
+    int actions;
+    bool requiresUnlock;
+    float unlockTimeout, minimumGestureDuration;
+    {
+        const GestureMachine& machine = getIngestGestures(armband->id);
+        actions = machine.getActions(trigger, armband->unlocked, armband->pose);
+        requiresUnlock = machine.getPolicy().requiresUnlock;
+        unlockTimeout = machine.getPolicy().unlockTimeout;
+        minimumGestureDuration = machine.getPolicy().minimumGestureDuration;
+    }
+
+    if (actions & GestureMachine::CONFIRM) {
+        armband->poseConfirmed = true;
+        notify(QueuedEvent::POSE_CONFIRMED, armband);
+    }
+
+    if (actions & GestureMachine::WAIT) {
+        scheduleDeadline(armband, DEADLINE_POSE, minimumGestureDuration);
+    }
+
+    if (actions & GestureMachine::TAP_UNLOCK || (actions & GestureMachine::UNLOCK && !armband->unlocked)) {
+        vibrate(armband, "short");
+        notifyUserAction(armband, "single");
+        unlockArmband(armband);
+    }
+    else if (actions & GestureMachine::UNLOCK) {
+        // stay unlocked for longer while the gesture's held
+        armband->unlockStartTime = getElapsedTimef();
+        if (requiresUnlock) scheduleDeadline(armband, DEADLINE_UNLOCK, unlockTimeout);
+    }
+
+    if (actions & GestureMachine::RELOCK) {
+        lockArmband(armband);
+        notify(QueuedEvent::LOCKED, armband);
+
+        // there's no such thing as locked if unlocking isn't required, so
+        // it's straight back to (a confirmed) rest
+        if (!requiresUnlock) {
+            armband->unlocked = true;
+            runGestureActions(armband, GestureMachine::HELD);
+        }
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::unlockArmband(ArmbandState* armband){
+
+    // not used past notify(), see runGestureActions()
+    const GesturePolicy& policy = getIngestGestures(armband->id).getPolicy();
+
+    armband->unlocked = true;
+    armband->unlockStartTime = getElapsedTimef();
+    if (policy.requiresUnlock) scheduleDeadline(armband, DEADLINE_UNLOCK, policy.unlockTimeout);
+
+    notify(QueuedEvent::UNLOCKED, armband);
+
+    // a pose held long enough while locked counts as soon as it's unlocked
+    if (!armband->poseConfirmed && armband->poseDeadline == 0 && armband->pose != POSE_UNKNOWN) {
+        runGestureActions(armband, GestureMachine::HELD);
+    }
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::lockArmband(ArmbandState* armband){
+    armband->unlocked = false;
+    armband->pose = POSE_REST;
+    armband->poseConfirmed = false;
+    armband->poseDeadline = 0;
+    armband->unlockDeadline = 0;
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::setEulerAngles(Armband* armband, float roll, float pitch, float yaw){
+
+    applyEulerConventions(roll, pitch, yaw, armband->direction, units.useDegrees());
+
+    armband->roll = roll;
+    armband->pitch = pitch;
+    armband->yaw = yaw;
+
+    // already worked out, so getEulerAngles() needn't do it again
+    armband->useDegrees = units.useDegrees();
+    armband->derived.euler.set(roll, pitch, yaw);
+    armband->derived.eulerDegrees = units.useDegrees();
+    armband->derived.eulerGeneration = armband->orientationGeneration;
+
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::onConnect( ofxLibwebsockets::Event& args ){
+    ofLogNotice("Socket Connected");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::onOpen( ofxLibwebsockets::Event& args ){
+
+    IngestLock lock(*this);
+
+    // Myo Connect tells us about every armband again on connecting, any
+    // still stale a little while later are gone
+    resyncing = ingestArmbands.size() > 0;
+    staleDeadline = getElapsedTimeMicros() + (uint64_t)(MAX(staleTimeout, 0.0f) * 1000000);
+
+    // checked as messages come in too, but there may not be any
+    if (resyncing) {
+        startScheduler();
+        scheduler.schedule(0, DEADLINE_STALE, staleDeadline);
+    }
+
+    // Myo Connect forgets this along with the connection. The rest of what
+    // it forgets is resent by update(), see resync().
+    for (int i = 0; i < emgStreaming.size(); i++) {
+        sendCommand(emgStreaming[i], "set_stream_emg", "enabled");
+    }
+
+    connected = true;
+    stats.addConnect();
+    ofLogNotice("Socket Open");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::onClose( ofxLibwebsockets::Event& args ){
+
+    IngestLock lock(*this);
+
+    // Keep the armbands, so a short drop doesn't lose arm sync or lock
+    // state, or leave anyone holding a dangling pointer
+    for (int i = 0; i < ingestArmbands.size(); i++) {
+        ingestArmbands[i]->stale = true;
+    }
+    resyncing = false;
+    publishArmbands();
+
+    connected = false;
+    stats.addDisconnect();
+    ofLogNotice("Socket Closed");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::onIdle( ofxLibwebsockets::Event& args ){
+    ofLogVerbose("Socket Idle");
+}
+
+//--------------------------------------------------------------
+template<class Policies>
+void BasicConnection<Policies>::onBroadcast( ofxLibwebsockets::Event& args ){
+    ofLogVerbose("Socket Broadcast");
+}
+
+}
@@ -0,0 +1,104 @@
+//
+//  ofxMyoWebSocketsEmgHistory
+//
+
+#include "ofxMyoWebSocketsEmgHistory.h"
+
+#include <string.h>
+
+using namespace ofxMyoWebSockets;
+
+//--------------------------------------------------------------
+uint64_t EmgSamples::timestamp(int i) const{
+    return history->timestamps[index(i)];
+}
+
+//--------------------------------------------------------------
+const int8_t* EmgSamples::sample(int i) const{
+    return &history->samples[index(i) * emgChannels];
+}
+
+//--------------------------------------------------------------
+int EmgSamples::copyTo(int8_t* samples, uint64_t* timestamps) const{
+
+    int offsets[2], lengths[2];
+    int runs = getRuns(offsets, lengths);
+    int copied = 0;
+
+    for (int i = 0; i < runs; i++) {
+        memcpy(samples + copied * emgChannels, history->getSamples() + offsets[i] * emgChannels, lengths[i] * emgChannels);
+        if (timestamps) memcpy(timestamps + copied, history->getTimestamps() + offsets[i], lengths[i] * sizeof(uint64_t));
+        copied += lengths[i];
+    }
+
+    // the copy only counts if none of it was overwritten while we were at it
+    return isValid() ? copied : 0;
+
+}
+
+//--------------------------------------------------------------
+bool EmgSamples::isValid() const{
+    return history && RingWindow::isValid(history->written);
+}
+
+//--------------------------------------------------------------
+EmgHistory::EmgHistory(){
+    written = 0;
+    oldest = 0;
+    setCapacity(1024);
+}
+
+//--------------------------------------------------------------
+void EmgHistory::setCapacity(int capacity){
+
+    int size = 1;
+    while (size < capacity) size <<= 1;
+
+    timestamps.assign(size, 0);
+    samples.assign(size * emgChannels, 0);
+
+    mask = size - 1;
+    written = 0;
+    oldest = 0;
+
+}
+
+//--------------------------------------------------------------
+void EmgHistory::clear(){
+    oldest.store(written.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+//--------------------------------------------------------------
+void EmgHistory::push(uint64_t timestamp, const int8_t sample[emgChannels]){
+
+    unsigned int sequence = written.load(std::memory_order_relaxed);
+    unsigned int i = sequence & mask;
+
+    timestamps[i] = timestamp;
+    memcpy(&samples[i * emgChannels], sample, emgChannels);
+
+    written.store(sequence + 1, std::memory_order_release);
+
+}
+
+//--------------------------------------------------------------
+EmgSamples EmgHistory::getAll() const{
+    unsigned int end = written.load(std::memory_order_acquire);
+    return EmgSamples(this, RingWindow::getReadable(mask, oldest.load(std::memory_order_acquire), end));
+}
+
+//--------------------------------------------------------------
+EmgSamples EmgHistory::getLast(int count) const{
+    return EmgSamples(this, getAll().getLast(count));
+}
+
+//--------------------------------------------------------------
+EmgSamples EmgHistory::getSince(uint64_t timestamp) const{
+    const uint64_t* timestamps = getTimestamps();
+    return EmgSamples(this, getAll().getSince(timestamp, [timestamps](int slot){ return timestamps[slot]; }));
+}
+
+//--------------------------------------------------------------
+EmgSamples EmgHistory::getFrom(unsigned int first) const{
+    return EmgSamples(this, getAll().getFrom(first));
+}
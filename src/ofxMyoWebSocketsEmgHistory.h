@@ -0,0 +1,106 @@
+//
+//  ofxMyoWebSocketsEmgHistory
+//
+//  Fixed-size ring buffer of timestamped raw EMG samples, 8 signed bytes per
+//  sample (one per sensor), stored back to back so windows of data can be
+//  handed to DSP code as they are. Written by the socket thread, readable
+//  from any other thread without locking.
+//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ofxMyoWebSocketsRing.h"
+
+namespace ofxMyoWebSockets {
+
+    const int emgChannels = 8;
+
+    class EmgHistory;
+
+    // A window of samples, oldest first. Like ImuSamples this refers back
+    // into the history rather than copying, so check isValid() if you hold
+    // on to it for a while, or copy it out with copyTo(). first, count,
+    // end(), index(), getRuns() etc. come from RingWindow.
+    struct EmgSamples : RingWindow {
+
+        const EmgHistory*   history;
+
+        EmgSamples() : history(NULL) {}
+        EmgSamples(const EmgHistory* history, const RingWindow& window) : RingWindow(window), history(history) {}
+
+        uint64_t        timestamp(int i) const;
+        const int8_t*   sample(int i) const;    // emgChannels values
+        int8_t          value(int i, int channel) const { return sample(i)[channel]; }
+
+        // Copies the window into one contiguous block of size() *
+        // emgChannels values, and size() timestamps unless timestamps is
+        // NULL. Returns the number of samples copied, or 0 if the socket
+        // thread overwrote some of them in the meantime, in which case ask
+        // the history for a fresh window.
+        int             copyTo(int8_t* samples, uint64_t* timestamps = NULL) const;
+
+        // False once the oldest sample has been (or is being) overwritten
+        bool            isValid() const;
+
+    };
+
+    class EmgHistory {
+
+    public:
+
+        EmgHistory();
+
+        // Rounded up to a power of two. Not thread safe, call before use.
+        void        setCapacity(int capacity);
+        int         getCapacity() const { return timestamps.size(); }
+
+        // Only the newest 3/4 of the buffer is handed out to readers, the
+        // rest is headroom (about 1.3s for 1024 samples at 200Hz)
+        int         getReadableCapacity() const { return RingWindow::getReadableCapacity(mask); }
+
+        // Writer side
+        void        clear();
+        void        push(uint64_t timestamp, const int8_t sample[emgChannels]);
+
+        // Reader side
+        EmgSamples  getAll() const;
+        EmgSamples  getLast(int count) const;
+        EmgSamples  getSince(uint64_t timestamp) const; // strictly newer than timestamp
+
+        // Everything from sequence number first on, e.g. the previous
+        // window's end(). Samples which have already dropped out of the
+        // readable part of the buffer are skipped, compare the window's
+        // first against what you asked for to see how many. Nothing's
+        // returned for a sequence number that hasn't been written yet.
+        EmgSamples  getFrom(unsigned int first) const;
+
+        // Total number of samples ever pushed, and the sequence number the
+        // next one will get
+        unsigned int getSampleCount() const { return written.load(std::memory_order_acquire); }
+
+        // Raw storage, indexed through EmgSamples::index() or getRuns().
+        // Sample i is emgChannels values starting at getSamples() + i *
+        // emgChannels.
+        const uint64_t* getTimestamps() const { return &timestamps[0]; }
+        const int8_t*   getSamples() const { return &samples[0]; }
+
+    private:
+
+        friend struct EmgSamples;
+
+        std::vector<uint64_t>       timestamps;
+        std::vector<int8_t>         samples;
+
+        unsigned int                mask;
+
+        std::atomic<uint32_t>       written;    // sequence number of the next sample
+        std::atomic<unsigned int>   oldest;     // nothing before this is readable (clear())
+
+    };
+
+}
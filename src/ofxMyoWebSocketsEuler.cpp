@@ -0,0 +1,281 @@
+//
+//  ofxMyoWebSocketsEuler
+//
+
+#include "ofxMyoWebSocketsEuler.h"
+
+#include <math.h>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define OFX_MYO_EULER_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define OFX_MYO_EULER_SSE
+#endif
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    const float halfPi = 1.57079632679f;
+    const float pi = 3.14159265359f;
+    const float radToDeg = 180.0f / pi;
+
+    // Minimax polynomial for atan(t) on [0, 1], odd terms only
+    const float a1 =  0.99997726f;
+    const float a3 = -0.33262347f;
+    const float a5 =  0.19354346f;
+    const float a7 = -0.11643287f;
+    const float a9 =  0.05265332f;
+    const float a11 = -0.01172120f;
+
+    inline float atanUnit(float t) {
+        float t2 = t * t;
+        return t * (a1 + t2 * (a3 + t2 * (a5 + t2 * (a7 + t2 * (a9 + t2 * a11)))));
+    }
+
+    inline void toEuler(float x, float y, float z, float w, float& roll, float& pitch, float& yaw) {
+        roll = fastAtan2(2.0f * (w * x + y * z), 1.0f - 2.0f * (x * x + y * y));
+        pitch = fastAsin(2.0f * (w * y - z * x));
+        yaw = fastAtan2(2.0f * (w * z + x * y), 1.0f - 2.0f * (y * y + z * z));
+    }
+
+#if defined(OFX_MYO_EULER_AVX)
+
+    typedef __m256 Vec;
+    const int width = 8;
+
+    inline Vec set1(float f) { return _mm256_set1_ps(f); }
+    inline Vec load(const float* p) { return _mm256_loadu_ps(p); }
+    inline void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+    inline Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    inline Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+    inline Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    inline Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+    inline Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+    inline Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+    inline Vec sqrt(Vec a) { return _mm256_sqrt_ps(a); }
+    inline Vec bitAnd(Vec a, Vec b) { return _mm256_and_ps(a, b); }
+    inline Vec bitXor(Vec a, Vec b) { return _mm256_xor_ps(a, b); }
+    inline Vec bitAndNot(Vec a, Vec b) { return _mm256_andnot_ps(a, b); }
+    inline Vec greater(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    inline Vec select(Vec mask, Vec a, Vec b) { return _mm256_blendv_ps(b, a, mask); }
+
+#elif defined(OFX_MYO_EULER_SSE)
+
+    typedef __m128 Vec;
+    const int width = 4;
+
+    inline Vec set1(float f) { return _mm_set1_ps(f); }
+    inline Vec load(const float* p) { return _mm_loadu_ps(p); }
+    inline void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+    inline Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+    inline Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+    inline Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+    inline Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+    inline Vec min(Vec a, Vec b) { return _mm_min_ps(a, b); }
+    inline Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+    inline Vec sqrt(Vec a) { return _mm_sqrt_ps(a); }
+    inline Vec bitAnd(Vec a, Vec b) { return _mm_and_ps(a, b); }
+    inline Vec bitXor(Vec a, Vec b) { return _mm_xor_ps(a, b); }
+    inline Vec bitAndNot(Vec a, Vec b) { return _mm_andnot_ps(a, b); }
+    inline Vec greater(Vec a, Vec b) { return _mm_cmpgt_ps(a, b); }
+    inline Vec select(Vec mask, Vec a, Vec b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+#endif
+
+#if defined(OFX_MYO_EULER_AVX) || defined(OFX_MYO_EULER_SSE)
+
+    inline Vec signBit() { return set1(-0.0f); }
+    inline Vec abs(Vec a) { return bitAndNot(signBit(), a); }
+
+    inline Vec atan2(Vec y, Vec x) {
+
+        Vec ax = abs(x);
+        Vec ay = abs(y);
+
+        // keep the ratio in [0, 1], and 0/0 at 0
+        Vec t = div(min(ax, ay), max(max(ax, ay), set1(1e-30f)));
+
+        Vec t2 = mul(t, t);
+        Vec r = set1(a11);
+        r = add(mul(r, t2), set1(a9));
+        r = add(mul(r, t2), set1(a7));
+        r = add(mul(r, t2), set1(a5));
+        r = add(mul(r, t2), set1(a3));
+        r = add(mul(r, t2), set1(a1));
+        r = mul(r, t);
+
+        // undo the folding into the first octant
+        r = select(greater(ay, ax), sub(set1(halfPi), r), r);
+        r = select(greater(set1(0.0f), x), sub(set1(pi), r), r);
+
+        // copy y's sign over
+        return bitXor(r, bitAnd(y, signBit()));
+
+    }
+
+    inline Vec asin(Vec a) {
+        a = min(max(a, set1(-1.0f)), set1(1.0f));
+        return atan2(a, sqrt(sub(set1(1.0f), mul(a, a))));
+    }
+
+#endif
+
+}
+
+//--------------------------------------------------------------
+float ofxMyoWebSockets::fastAtan2(float y, float x){
+
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+
+    float mx = ax > ay ? ax : ay;
+    float mn = ax > ay ? ay : ax;
+    float t = mx > 1e-30f ? mn / mx : 0;
+
+    float r = atanUnit(t);
+
+    if (ay > ax) r = halfPi - r;
+    if (x < 0) r = pi - r;
+    return y < 0 ? -r : r;
+
+}
+
+//--------------------------------------------------------------
+float ofxMyoWebSockets::fastAsin(float x){
+    if (x > 1.0f) x = 1.0f;
+    if (x < -1.0f) x = -1.0f;
+    return fastAtan2(x, sqrtf(1.0f - x * x));
+}
+
+//--------------------------------------------------------------
+void ofxMyoWebSockets::applyEulerConventions(float& roll, float& pitch, float& yaw, XDirection direction, bool degrees){
+
+    // convert to degrees if the setting is on
+    if (degrees) {
+        roll *= radToDeg;
+        pitch *= radToDeg;
+        yaw *= radToDeg;
+    }
+
+    // flip pitch so that...
+    // - up is positive
+    // - down is negative
+    if (direction == X_DIRECTION_TOWARD_WRIST)
+        pitch *= -1;
+
+    // flip roll so that...
+    // - rolling right is positive roll
+    // - rolling left is negative
+    if (direction == X_DIRECTION_TOWARD_ELBOW)
+        roll *= -1;
+
+}
+
+//--------------------------------------------------------------
+void ofxMyoWebSockets::quaternionsToEuler(const float* x, const float* y, const float* z, const float* w, int count,
+                                          float* roll, float* pitch, float* yaw){
+
+    int i = 0;
+
+#if defined(OFX_MYO_EULER_AVX) || defined(OFX_MYO_EULER_SSE)
+
+    Vec one = set1(1.0f);
+    Vec two = set1(2.0f);
+
+    for (; i + width <= count; i += width) {
+
+        Vec qx = load(x + i);
+        Vec qy = load(y + i);
+        Vec qz = load(z + i);
+        Vec qw = load(w + i);
+
+        // same formulas as the scalar version below
+        Vec rollY = mul(two, add(mul(qw, qx), mul(qy, qz)));
+        Vec rollX = sub(one, mul(two, add(mul(qx, qx), mul(qy, qy))));
+        Vec pitchSin = mul(two, sub(mul(qw, qy), mul(qz, qx)));
+        Vec yawY = mul(two, add(mul(qw, qz), mul(qx, qy)));
+        Vec yawX = sub(one, mul(two, add(mul(qy, qy), mul(qz, qz))));
+
+        store(roll + i, atan2(rollY, rollX));
+        store(pitch + i, asin(pitchSin));
+        store(yaw + i, atan2(yawY, yawX));
+    }
+
+#endif
+
+    // whatever doesn't fill a whole vector
+    for (; i < count; i++) {
+        toEuler(x[i], y[i], z[i], w[i], roll[i], pitch[i], yaw[i]);
+    }
+
+}
+
+//--------------------------------------------------------------
+void EulerBatch::reserve(int count){
+    x.reserve(count);
+    y.reserve(count);
+    z.reserve(count);
+    w.reserve(count);
+    roll.reserve(count);
+    pitch.reserve(count);
+    yaw.reserve(count);
+}
+
+//--------------------------------------------------------------
+void EulerBatch::clear(){
+    x.clear();
+    y.clear();
+    z.clear();
+    w.clear();
+}
+
+//--------------------------------------------------------------
+int EulerBatch::add(float qx, float qy, float qz, float qw){
+    x.push_back(qx);
+    y.push_back(qy);
+    z.push_back(qz);
+    w.push_back(qw);
+    return x.size() - 1;
+}
+
+//--------------------------------------------------------------
+void EulerBatch::convert(){
+
+    int count = size();
+
+    roll.resize(count);
+    pitch.resize(count);
+    yaw.resize(count);
+
+    if (count == 0) return;
+
+    quaternionsToEuler(&x[0], &y[0], &z[0], &w[0], count, &roll[0], &pitch[0], &yaw[0]);
+
+}
+
+//--------------------------------------------------------------
+void EulerBatch::convert(const ImuSamples& samples){
+
+    clear();
+    if (samples.empty()) {
+        convert();
+        return;
+    }
+
+    // copy the window out first, it may wrap around the end of the history
+    int offsets[2], lengths[2];
+    int runs = samples.getRuns(offsets, lengths);
+
+    for (int r = 0; r < runs; r++) {
+        x.insert(x.end(), samples.history->getQuat(0) + offsets[r], samples.history->getQuat(0) + offsets[r] + lengths[r]);
+        y.insert(y.end(), samples.history->getQuat(1) + offsets[r], samples.history->getQuat(1) + offsets[r] + lengths[r]);
+        z.insert(z.end(), samples.history->getQuat(2) + offsets[r], samples.history->getQuat(2) + offsets[r] + lengths[r]);
+        w.insert(w.end(), samples.history->getQuat(3) + offsets[r], samples.history->getQuat(3) + offsets[r] + lengths[r]);
+    }
+
+    convert();
+
+}
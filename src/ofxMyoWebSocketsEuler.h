@@ -0,0 +1,66 @@
+//
+//  ofxMyoWebSocketsEuler
+//
+//  Quaternion to roll, pitch & yaw conversion in bulk, on arrays of
+//  components (x[], y[], z[], w[] in, roll[], pitch[], yaw[] out) so it can
+//  run 4 or 8 quaternions at a time with SSE or AVX. Falls back on plain
+//  scalar code elsewhere.
+//
+//  atan2 and asin are polynomial approximations, within 2e-6 radians of the
+//  exact functions. With the rounding of the float quaternion terms on top,
+//  roll, pitch & yaw are within 3e-5 radians (0.002 degrees) of a double
+//  precision conversion, far below the noise of the armband's own
+//  orientation estimate. Within a few degrees of pointing straight up or
+//  down, asin magnifies that rounding, and pitch is only within 1e-3.
+//
+
+#pragma once
+
+#include <vector>
+
+#include "ofxMyoWebSocketsImuHistory.h"
+#include "ofxMyoWebSocketsTypes.h"
+
+namespace ofxMyoWebSockets {
+
+    // Scalar versions of the approximations, max error 2e-6 radians.
+    // fastAsin() clamps its input to [-1, 1] rather than returning NaN.
+    float   fastAtan2(float y, float x);
+    float   fastAsin(float x);
+
+    // Radians, using the same convention as Armband::roll/pitch/yaw (before
+    // any degree conversion or direction flips). Any of the arrays may be
+    // unaligned.
+    void    quaternionsToEuler(const float* x, const float* y, const float* z, const float* w, int count,
+                               float* roll, float* pitch, float* yaw);
+
+    // Takes angles in radians as they come out of the conversion to the
+    // units & signs of Armband::roll/pitch/yaw: degrees if asked for, up
+    // positive for pitch and right positive for roll, whichever way the
+    // armband is worn
+    void    applyEulerConventions(float& roll, float& pitch, float& yaw, XDirection direction, bool degrees);
+
+    // Quaternions in, angles out, all as separate arrays. Fill it with
+    // add() or by writing straight into x/y/z/w, then convert().
+    struct EulerBatch {
+
+        std::vector<float>  x, y, z, w;
+        std::vector<float>  roll, pitch, yaw;
+
+        void    reserve(int count);
+        void    clear();
+        int     size() const { return x.size(); }
+
+        // Returns the index of the quaternion
+        int     add(float qx, float qy, float qz, float qw);
+
+        // Angles for every quaternion added so far
+        void    convert();
+
+        // Replaces the contents with a window from an armband's history, e.g.
+        // batch.convert(armband->history->getLast(50))
+        void    convert(const ImuSamples& samples);
+
+    };
+
+}
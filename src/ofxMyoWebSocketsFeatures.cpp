@@ -0,0 +1,207 @@
+//
+//  ofxMyoWebSocketsFeatures
+//
+
+#include "ofxMyoWebSocketsFeatures.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+using namespace ofxMyoWebSockets;
+
+//--------------------------------------------------------------
+void SlidingWelford::add(double x){
+    count++;
+    double delta = x - mean;
+    mean += delta / count;
+    m2 += delta * (x - mean);
+}
+
+//--------------------------------------------------------------
+void SlidingWelford::replace(double oldest, double x){
+    double oldMean = mean;
+    mean += (x - oldest) / count;
+    m2 += (x - oldest) * (x - mean + oldest - oldMean);
+}
+
+//--------------------------------------------------------------
+void SlidingWelford::set(const float* values, int count){
+
+    // two passes, as exact as doubles get
+    double sum = 0;
+    for (int i = 0; i < count; i++) sum += values[i];
+
+    this->count = count;
+    mean = count > 0 ? sum / count : 0;
+    m2 = 0;
+
+    for (int i = 0; i < count; i++) {
+        double delta = values[i] - mean;
+        m2 += delta * delta;
+    }
+
+}
+
+//--------------------------------------------------------------
+void FeatureExtractor::ImuWindow::resize(int length){
+    values.assign(length, 0);
+    clear();
+}
+
+//--------------------------------------------------------------
+void FeatureExtractor::ImuWindow::clear(){
+    count = 0;
+    next = 0;
+    replaced = 0;
+    stats.clear();
+}
+
+//--------------------------------------------------------------
+void FeatureExtractor::ImuWindow::add(float value){
+
+    int length = values.size();
+
+    if (count < length) {
+        stats.add(value);
+        count++;
+    } else {
+        stats.replace(values[next], value);
+        replaced++;
+    }
+
+    values[next] = value;
+    next = (next + 1) % length;
+
+    // once per trip round the window, so it's still the same cost per
+    // sample on average
+    if (replaced >= length) {
+        stats.set(&values[0], count);
+        replaced = 0;
+    }
+
+}
+
+//--------------------------------------------------------------
+FeatureExtractor::FeatureExtractor(){
+    setWindows(40, 10);
+}
+
+//--------------------------------------------------------------
+void FeatureExtractor::setWindows(int emgSamples, int imuSamples){
+
+    emgWindow = emgSamples > 1 ? emgSamples : 1;
+    imuWindow = imuSamples > 1 ? imuSamples : 1;
+
+    this->emgSamples.assign(emgWindow * emgChannels, 0);
+    emgCrossings.assign(emgWindow, 0);
+
+    angularSpeed.resize(imuWindow);
+    jerk.resize(imuWindow);
+
+    clear();
+
+}
+
+//--------------------------------------------------------------
+void FeatureExtractor::clear(){
+
+    emgCount = 0;
+    emgNext = 0;
+
+    for (int i = 0; i < emgChannels; i++) {
+        sumAbs[i] = 0;
+        sumSquares[i] = 0;
+        crossings[i] = 0;
+        lastSign[i] = 0;
+    }
+
+    hasLastAccel = false;
+
+    angularSpeed.clear();
+    jerk.clear();
+
+}
+
+//--------------------------------------------------------------
+void FeatureExtractor::addEmg(const int8_t sample[emgChannels]){
+
+    int8_t* slot = &emgSamples[emgNext * emgChannels];
+    uint8_t& crossed = emgCrossings[emgNext];
+
+    // take the oldest sample out once the window is full
+    if (emgCount == emgWindow) {
+        for (int i = 0; i < emgChannels; i++) {
+            int value = slot[i];
+            sumAbs[i] -= abs(value);
+            sumSquares[i] -= value * value;
+            if (crossed & (1 << i)) crossings[i]--;
+        }
+    } else {
+        emgCount++;
+    }
+
+    crossed = 0;
+
+    for (int i = 0; i < emgChannels; i++) {
+
+        int value = sample[i];
+        slot[i] = value;
+        sumAbs[i] += abs(value);
+        sumSquares[i] += value * value;
+
+        if (abs(value) < zeroCrossingThreshold) continue;
+
+        int8_t sign = value > 0 ? 1 : -1;
+        if (lastSign[i] && sign != lastSign[i]) {
+            crossed |= 1 << i;
+            crossings[i]++;
+        }
+        lastSign[i] = sign;
+    }
+
+    emgNext = (emgNext + 1) % emgWindow;
+
+}
+
+//--------------------------------------------------------------
+void FeatureExtractor::addImu(const float accel[3], const float gyro[3]){
+
+    angularSpeed.add(sqrtf(gyro[0] * gyro[0] + gyro[1] * gyro[1] + gyro[2] * gyro[2]));
+
+    // there's no change in acceleration until the second sample, rather
+    // than a change of 0
+    if (hasLastAccel) {
+        float dx = accel[0] - lastAccel[0];
+        float dy = accel[1] - lastAccel[1];
+        float dz = accel[2] - lastAccel[2];
+        jerk.add(sqrtf(dx * dx + dy * dy + dz * dz) * imuRate);
+    }
+
+    lastAccel[0] = accel[0];
+    lastAccel[1] = accel[1];
+    lastAccel[2] = accel[2];
+    hasLastAccel = true;
+
+}
+
+//--------------------------------------------------------------
+void FeatureExtractor::getFeatures(Features& features) const{
+
+    EmgFeatures& emg = features.emg;
+    emg.samples = emgCount;
+
+    for (int i = 0; i < emgChannels; i++) {
+        float n = emgCount > 0 ? emgCount : 1;
+        emg.rms[i] = sqrtf(sumSquares[i] / n);
+        emg.meanAbsoluteValue[i] = sumAbs[i] / n;
+        emg.zeroCrossings[i] = crossings[i];
+    }
+
+    ImuFeatures& imu = features.imu;
+    imu.samples = angularSpeed.count;
+    imu.angularSpeed = angularSpeed.stats.mean;
+    imu.angularSpeedDeviation = sqrt(angularSpeed.stats.getVariance());
+    imu.jerk = jerk.stats.mean;
+    imu.jerkDeviation = sqrt(jerk.stats.getVariance());
+
+}
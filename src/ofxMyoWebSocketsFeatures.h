@@ -0,0 +1,138 @@
+//
+//  ofxMyoWebSocketsFeatures
+//
+//  Features commonly fed to gesture classifiers, kept up to date over a
+//  sliding window of the latest samples as they come in. Each sample costs
+//  the same no matter how long the window is: EMG uses exact integer
+//  running sums, IMU uses Welford's algorithm updated in place as samples
+//  enter and leave the window, and worked out afresh from the window each
+//  time it's turned over so rounding can't build up.
+//
+
+#pragma once
+
+#include <vector>
+#include <stdint.h>
+
+#include "ofxMyoWebSocketsEmgHistory.h"
+
+namespace ofxMyoWebSockets {
+
+    struct EmgFeatures {
+
+        int     samples;        // in the window so far, up to its length
+
+        // Per sensor, in raw EMG units (-128 to 127)
+        float   rms[emgChannels];
+        float   meanAbsoluteValue[emgChannels];
+
+        // Sign changes bigger than FeatureExtractor::zeroCrossingThreshold,
+        // over the window
+        int     zeroCrossings[emgChannels];
+
+    };
+
+    struct ImuFeatures {
+
+        int     samples;        // in the window so far, up to its length
+
+        // Length of the gyro vector, deg/s
+        float   angularSpeed;
+        float   angularSpeedDeviation;
+
+        // Length of the change in acceleration between samples, g/s. There's
+        // none for the very first sample, so it has one sample fewer until
+        // the window's full.
+        float   jerk;
+        float   jerkDeviation;
+
+    };
+
+    struct Features {
+        EmgFeatures     emg;
+        ImuFeatures     imu;
+    };
+
+    // Mean and variance over a sliding window. Add samples until the window
+    // is full, then replace the oldest with each new one. Every replace()
+    // rounds a little differently to starting over, so set() it from the
+    // window itself now and then.
+    struct SlidingWelford {
+
+        SlidingWelford() { clear(); }
+
+        void    clear() { count = 0; mean = 0; m2 = 0; }
+        void    add(double x);
+        void    replace(double oldest, double x);
+        void    set(const float* values, int count);
+
+        double  getVariance() const { return count > 1 && m2 > 0 ? m2 / count : 0; }
+
+        int     count;
+        double  mean;
+        double  m2;     // sum of squared differences from the mean
+
+    };
+
+    class FeatureExtractor {
+
+    public:
+
+        // Dead band for EMG zero crossings, so noise around 0 doesn't count
+        static const int    zeroCrossingThreshold = 10;
+
+        // The IMU streams at a fixed rate, and arrival times are too jittery
+        // to divide by
+        static const int    imuRate = 50;
+
+        FeatureExtractor();
+
+        // Window lengths in samples, e.g. 40 EMG samples and 10 IMU samples
+        // both cover 0.2 seconds. Allocates, so not while streaming.
+        void    setWindows(int emgSamples, int imuSamples);
+        void    clear();
+
+        void    addEmg(const int8_t sample[emgChannels]);
+        void    addImu(const float accel[3], const float gyro[3]);
+
+        void    getFeatures(Features& features) const;
+
+    private:
+
+        // EMG, the raw samples in the window and whether each one crossed
+        // zero since the one before, a bit per channel
+        std::vector<int8_t>     emgSamples;
+        std::vector<uint8_t>    emgCrossings;
+        int                     emgWindow;
+        int                     emgCount;
+        int                     emgNext;
+
+        int64_t                 sumAbs[emgChannels];
+        int64_t                 sumSquares[emgChannels];
+        int                     crossings[emgChannels];
+        int8_t                  lastSign[emgChannels];  // of the last sample past the dead band
+
+        // IMU, per sample values in the window. Jerk starts a sample later,
+        // so it has a window of its own.
+        struct ImuWindow {
+            std::vector<float>  values;
+            int                 count;
+            int                 next;
+            int                 replaced;   // since it was last set() afresh
+            SlidingWelford      stats;
+
+            void    resize(int length);
+            void    clear();
+            void    add(float value);
+        };
+
+        int                     imuWindow;
+        bool                    hasLastAccel;
+        float                   lastAccel[3];
+
+        ImuWindow               angularSpeed;
+        ImuWindow               jerk;
+
+    };
+
+}
@@ -0,0 +1,166 @@
+//
+//  ofxMyoWebSocketsGestures
+//
+
+#include "ofxMyoWebSocketsGestures.h"
+
+#include <algorithm>
+#include <string.h>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    bool contains(const std::vector<Pose>& poses, Pose pose) {
+        return std::find(poses.begin(), poses.end(), pose) != poses.end();
+    }
+
+}
+
+//--------------------------------------------------------------
+GesturePolicy::GesturePolicy(){
+
+    requiresUnlock = false;
+    unlockTimeout = 3.0f;
+    minimumGestureDuration = 0.33f;
+    lockAfterPose = true;
+
+    immediatePoses.push_back(POSE_REST);
+
+    unlockPoses.push_back(POSE_THUMB_TO_PINKY);
+    unlockPoses.push_back(POSE_DOUBLE_TAP);
+
+    tapUnlockPoses.push_back(POSE_DOUBLE_TAP);
+
+}
+
+//--------------------------------------------------------------
+int GesturePolicy::addSequence(const std::string& name, const std::vector<Pose>& poses, float within, bool unlocks){
+
+    PoseSequence sequence;
+    sequence.name = name;
+    sequence.poses = poses;
+    sequence.within = within;
+    sequence.unlocks = unlocks;
+
+    sequences.push_back(sequence);
+    return sequences.size() - 1;
+
+}
+
+//--------------------------------------------------------------
+void PoseHistory::push(Pose pose, uint64_t time){
+    poses[next] = pose;
+    times[next] = time;
+    next = (next + 1) % size;
+    if (count < size) count++;
+}
+
+//--------------------------------------------------------------
+GestureMachine::GestureMachine(){
+    compile(GesturePolicy());
+}
+
+//--------------------------------------------------------------
+GestureMachine::GestureMachine(const GesturePolicy& policy){
+    compile(policy);
+}
+
+//--------------------------------------------------------------
+void GestureMachine::compile(const GesturePolicy& policy){
+
+    this->policy = policy;
+    memset(table, 0, sizeof(table));
+
+    for (int unlocked = 0; unlocked < 2; unlocked++) {
+
+        // poses only count while unlocked, if unlocking is required at all
+        bool allowed = unlocked || !policy.requiresUnlock;
+
+        for (int p = 0; p < numPoses; p++) {
+
+            Pose pose = (Pose)p;
+            bool immediate = contains(policy.immediatePoses, pose);
+
+            unsigned char& started = table[STARTED][unlocked][p];
+            unsigned char& held = table[HELD][unlocked][p];
+
+            if (immediate) {
+                if (allowed) started |= CONFIRM;
+            } else {
+                started |= WAIT;
+            }
+
+            if (contains(policy.tapUnlockPoses, pose)) started |= TAP_UNLOCK;
+
+            if (allowed) held |= CONFIRM;
+            if (immediate) continue;
+
+            if (contains(policy.unlockPoses, pose)) {
+                held |= UNLOCK;
+            } else if (policy.lockAfterPose && unlocked) {
+                held |= RELOCK;
+            }
+        }
+    }
+
+    sequences.clear();
+
+    for (int i = 0; i < policy.sequences.size(); i++) {
+
+        const PoseSequence& source = policy.sequences[i];
+
+        CompiledSequence sequence;
+        sequence.length = std::min((int)source.poses.size(), (int)PoseHistory::size);
+        sequence.within = source.within * 1000000;
+        sequence.skipRest = !contains(source.poses, POSE_REST);
+
+        for (int j = 0; j < sequence.length; j++) {
+            sequence.poses[j] = source.poses[j];
+        }
+
+        sequences.push_back(sequence);
+    }
+
+}
+
+//--------------------------------------------------------------
+int GestureMachine::matchSequence(const PoseHistory& history) const {
+
+    if (history.count == 0) return -1;
+
+    for (int i = 0; i < sequences.size(); i++) {
+
+        const CompiledSequence& sequence = sequences[i];
+        if (sequence.length == 0) continue;
+
+        // has to end on the pose that just started
+        if (history.getPose(0) != sequence.poses[sequence.length - 1]) continue;
+
+        // walk both backwards from the latest pose
+        int back = 0;
+        int matched = 0;
+
+        while (matched < sequence.length && back < history.count) {
+
+            Pose pose = history.getPose(back);
+
+            if ((pose == POSE_REST || pose == POSE_UNKNOWN) && sequence.skipRest) {
+                back++;
+                continue;
+            }
+
+            if (pose != sequence.poses[sequence.length - 1 - matched]) break;
+
+            matched++;
+            back++;
+        }
+
+        if (matched < sequence.length) continue;
+
+        if (history.getTime(0) - history.getTime(back - 1) <= sequence.within) return i;
+    }
+
+    return -1;
+
+}
@@ -0,0 +1,132 @@
+//
+//  ofxMyoWebSocketsGestures
+//
+//  Pose confirmation and locking rules. A GesturePolicy describes them, and
+//  is compiled into a GestureMachine: a lookup table from (trigger, locked
+//  or unlocked, pose) to the actions to take, so handling a pose is a
+//  single table lookup. Also matches pose sequences, e.g. a fist followed by
+//  wave in within half a second. Nothing allocates once compiled.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "ofxMyoWebSocketsTypes.h"
+
+namespace ofxMyoWebSockets {
+
+    const int numPoses = POSE_THUMB_TO_PINKY + 1;
+
+    struct PoseSequence {
+        std::string         name;
+        std::vector<Pose>   poses;
+        float               within;     // seconds from the first pose starting to the last
+        bool                unlocks;    // e.g. a custom unlock gesture
+    };
+
+    struct GesturePolicy {
+
+        // The defaults: no unlocking needed, poses confirmed after 0.33
+        // seconds, rest confirmed straight away, thumb to pinky or double
+        // tap to unlock
+        GesturePolicy();
+
+        bool    requiresUnlock;
+        float   unlockTimeout;
+        float   minimumGestureDuration;
+        bool    lockAfterPose;
+
+        // Confirmed as soon as they start
+        std::vector<Pose>   immediatePoses;
+
+        // Unlock once held for minimumGestureDuration
+        std::vector<Pose>   unlockPoses;
+
+        // Unlock as soon as they start, and acknowledge with a vibration
+        // every time, even if already unlocked
+        std::vector<Pose>   tapUnlockPoses;
+
+        // Rest in between poses is skipped, unless the sequence has rest in
+        // it. At most PoseHistory::size poses long. Sequences are matched
+        // whether the armband is locked or not.
+        std::vector<PoseSequence>   sequences;
+
+        // Returns the sequence's index, i.e. Armband::sequence once it's
+        // been performed
+        int     addSequence(const std::string& name, const std::vector<Pose>& poses, float within, bool unlocks = false);
+
+    };
+
+    // The last few poses an armband started, for matching sequences
+    struct PoseHistory {
+
+        static const int    size = 8;
+
+        PoseHistory() { clear(); }
+
+        void        clear() { count = 0; next = 0; }
+        void        push(Pose pose, uint64_t time);
+
+        // 0 is the latest
+        Pose        getPose(int back) const { return poses[(next - 1 - back + size) % size]; }
+        uint64_t    getTime(int back) const { return times[(next - 1 - back + size) % size]; }
+
+        Pose        poses[size];
+        uint64_t    times[size];    // microseconds
+        int         count;
+        int         next;
+
+    };
+
+    class GestureMachine {
+
+    public:
+
+        enum Trigger {
+            STARTED,        // Myo Connect reported a new pose
+            HELD            // held for minimumGestureDuration, or unlocked while held
+        };
+
+        enum Action {
+            CONFIRM     = 1,    // confirm the pose
+            WAIT        = 2,    // come back with HELD after minimumGestureDuration
+            UNLOCK      = 4,    // unlock if locked, or stay unlocked for longer
+            TAP_UNLOCK  = 8,    // unlock, with feedback even if already unlocked
+            RELOCK      = 16    // lock again
+        };
+
+        GestureMachine();
+        GestureMachine(const GesturePolicy& policy);
+
+        void    compile(const GesturePolicy& policy);
+
+        const GesturePolicy&    getPolicy() const { return policy; }
+
+        // A combination of Actions
+        int     getActions(Trigger trigger, bool unlocked, Pose pose) const {
+            return table[trigger][unlocked ? 1 : 0][pose];
+        }
+
+        // Index into the policy's sequences of one the latest pose in history
+        // completes, or -1
+        int     matchSequence(const PoseHistory& history) const;
+
+    private:
+
+        struct CompiledSequence {
+            Pose        poses[PoseHistory::size];
+            int         length;
+            uint64_t    within;     // microseconds
+            bool        skipRest;
+        };
+
+        GesturePolicy               policy;
+        unsigned char               table[2][2][numPoses];
+        std::vector<CompiledSequence>   sequences;
+
+    };
+
+}
@@ -0,0 +1,193 @@
+//
+//  ofxMyoWebSocketsHub
+//
+
+#include "ofxMyoWebSocketsHub.h"
+
+using namespace ofxMyoWebSockets;
+
+//--------------------------------------------------------------
+Hub::Hub(){
+}
+
+//--------------------------------------------------------------
+Hub::~Hub(){
+    for (int i = 0; i < hosts.size(); i++) {
+        removeListeners(*hosts[i].connection);
+    }
+}
+
+//--------------------------------------------------------------
+int Hub::addHost(string hostname, int port){
+
+    Host host;
+    host.hostname = hostname;
+    host.port = port;
+    host.connection.reset(new Connection());
+
+    // each host's socket thread has its own events, queue them all up so
+    // they come out of one place in update()
+    host.connection->setHost(hosts.size());
+    host.connection->setQueuedEvents(true);
+    addListeners(*host.connection);
+
+    hosts.push_back(std::move(host));
+    return hosts.size() - 1;
+
+}
+
+//--------------------------------------------------------------
+void Hub::connect(bool autoReconnect){
+    for (int i = 0; i < hosts.size(); i++) {
+        hosts[i].connection->connect(hosts[i].hostname, hosts[i].port, autoReconnect);
+    }
+}
+
+//--------------------------------------------------------------
+void Hub::update(){
+
+    for (int i = 0; i < hosts.size(); i++) {
+        hosts[i].connection->beginUpdate();
+    }
+
+    // so listeners see every host's armbands as of this update
+    armbands.clear();
+
+    for (int i = 0; i < hosts.size(); i++) {
+        const vector<Armband*>& hostArmbands = hosts[i].connection->armbands;
+        armbands.insert(armbands.end(), hostArmbands.begin(), hostArmbands.end());
+    }
+
+    sort(armbands.begin(), armbands.end(), compareArmbands);
+
+    // Merge the hosts' events by arrival time, the earliest host first
+    // for a tie. Each host's own events are already in order.
+    for (int i = 0; i < hosts.size(); i++) {
+        hosts[i].connection->collectQueuedEvents();
+    }
+
+    while (true) {
+
+        Connection* next = NULL;
+        uint64_t received = 0;
+
+        for (int i = 0; i < hosts.size(); i++) {
+            const QueuedEvent* event = hosts[i].connection->peekQueuedEvent();
+            if (event && (!next || event->received < received)) {
+                next = hosts[i].connection.get();
+                received = event->received;
+            }
+        }
+
+        if (!next) break;
+        next->fireQueuedEvent();
+    }
+
+    for (int i = 0; i < hosts.size(); i++) {
+        hosts[i].connection->endUpdate();
+    }
+
+}
+
+//--------------------------------------------------------------
+bool Hub::compareArmbands(const Armband* a, const Armband* b){
+    if (a->host != b->host) return a->host < b->host;
+    return a->id < b->id;
+}
+
+//--------------------------------------------------------------
+Armband* Hub::getArmband(int host, int myoID){
+    if (host < 0 || host >= hosts.size()) return NULL;
+    return hosts[host].connection->findArmband(myoID);
+}
+
+//--------------------------------------------------------------
+Armband* Hub::getArmband(int globalId){
+    return getArmband(globalId / idsPerHost, globalId % idsPerHost);
+}
+
+//--------------------------------------------------------------
+Connection* Hub::getConnection(const Armband* armband){
+    if (!armband || armband->host < 0 || armband->host >= hosts.size()) return NULL;
+    return hosts[armband->host].connection.get();
+}
+
+//--------------------------------------------------------------
+void Hub::sendCommand(Armband* armband, string command, string type){
+    Connection* connection = getConnection(armband);
+    if (connection) connection->sendCommand(armband, command, type);
+}
+
+//--------------------------------------------------------------
+void Hub::notifyUserAction(Armband* armband, string type){
+    Connection* connection = getConnection(armband);
+    if (connection) connection->notifyUserAction(armband, type);
+}
+
+//--------------------------------------------------------------
+void Hub::vibrate(Armband* armband, string type){
+    Connection* connection = getConnection(armband);
+    if (connection) connection->vibrate(armband, type);
+}
+
+//--------------------------------------------------------------
+void Hub::requestSignalStrength(Armband* armband){
+    Connection* connection = getConnection(armband);
+    if (connection) connection->requestSignalStrength(armband);
+}
+
+//--------------------------------------------------------------
+void Hub::lock(Armband* armband){
+    Connection* connection = getConnection(armband);
+    if (connection) connection->lock(armband);
+}
+
+//--------------------------------------------------------------
+void Hub::unlock(Armband* armband, string type){
+    Connection* connection = getConnection(armband);
+    if (connection) connection->unlock(armband, type);
+}
+
+//--------------------------------------------------------------
+void Hub::setStreamEmg(Armband* armband, bool enabled){
+    Connection* connection = getConnection(armband);
+    if (connection) connection->setStreamEmg(armband, enabled);
+}
+
+//--------------------------------------------------------------
+void Hub::addListeners(Connection& connection){
+    ofAddListener(connection.pairedEvent, this, &Hub::onPaired);
+    ofAddListener(connection.unpairedEvent, this, &Hub::onUnpaired);
+    ofAddListener(connection.connectedEvent, this, &Hub::onConnected);
+    ofAddListener(connection.disconnectedEvent, this, &Hub::onDisconnected);
+    ofAddListener(connection.armRecognizedEvent, this, &Hub::onArmRecognized);
+    ofAddListener(connection.armLostEvent, this, &Hub::onArmLost);
+    ofAddListener(connection.armSyncedEvent, this, &Hub::onArmSynced);
+    ofAddListener(connection.armUnsyncedEvent, this, &Hub::onArmUnsynced);
+    ofAddListener(connection.unlockedEvent, this, &Hub::onUnlocked);
+    ofAddListener(connection.lockedEvent, this, &Hub::onLocked);
+    ofAddListener(connection.poseStartedEvent, this, &Hub::onPoseStarted);
+    ofAddListener(connection.poseConfirmedEvent, this, &Hub::onPoseConfirmed);
+    ofAddListener(connection.poseSequenceEvent, this, &Hub::onPoseSequence);
+    ofAddListener(connection.orientationEvent, this, &Hub::onOrientation);
+    ofAddListener(connection.rssiReceivedEvent, this, &Hub::onRssiReceived);
+}
+
+//--------------------------------------------------------------
+void Hub::removeListeners(Connection& connection){
+    ofRemoveListener(connection.pairedEvent, this, &Hub::onPaired);
+    ofRemoveListener(connection.unpairedEvent, this, &Hub::onUnpaired);
+    ofRemoveListener(connection.connectedEvent, this, &Hub::onConnected);
+    ofRemoveListener(connection.disconnectedEvent, this, &Hub::onDisconnected);
+    ofRemoveListener(connection.armRecognizedEvent, this, &Hub::onArmRecognized);
+    ofRemoveListener(connection.armLostEvent, this, &Hub::onArmLost);
+    ofRemoveListener(connection.armSyncedEvent, this, &Hub::onArmSynced);
+    ofRemoveListener(connection.armUnsyncedEvent, this, &Hub::onArmUnsynced);
+    ofRemoveListener(connection.unlockedEvent, this, &Hub::onUnlocked);
+    ofRemoveListener(connection.lockedEvent, this, &Hub::onLocked);
+    ofRemoveListener(connection.poseStartedEvent, this, &Hub::onPoseStarted);
+    ofRemoveListener(connection.poseConfirmedEvent, this, &Hub::onPoseConfirmed);
+    ofRemoveListener(connection.poseSequenceEvent, this, &Hub::onPoseSequence);
+    ofRemoveListener(connection.orientationEvent, this, &Hub::onOrientation);
+    ofRemoveListener(connection.rssiReceivedEvent, this, &Hub::onRssiReceived);
+}
@@ -0,0 +1,113 @@
+//
+//  ofxMyoWebSocketsHub
+//
+//  One Connection per Myo Connect host, for spreading armbands over several
+//  Bluetooth radios (or machines) and treating them as one set. Armbands
+//  are told apart by Armband::host, since Myo ids are only unique per host.
+//
+//  Every host's events are queued and fired from update() on the main
+//  thread, merged by arrival time (the hosts share a clock unless you give
+//  them one each with setClock()), with the armband list already brought
+//  up to date. The merged armband list is sorted by host, then id.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxMyoWebSockets.h"
+
+namespace ofxMyoWebSockets {
+
+    class Hub {
+
+    public:
+
+        Hub();
+        ~Hub();
+
+        // Returns the index of the host, which is also Armband::host for its
+        // armbands. Add every host before connect().
+        int                 addHost(string hostname, int port = 10138);
+        int                 getNumHosts() { return hosts.size(); }
+
+        // To change settings for one host, call before connect()
+        Connection&         getConnection(int host) { return *hosts[host].connection; }
+
+        void                connect(bool autoReconnect = true);
+        void                update();
+
+        // Every armband on every host as of the last update(), sorted by
+        // host, then id
+        vector<Armband*>    armbands;
+
+        // NULL if there's no such armband
+        Armband*            getArmband(int host, int myoID);
+        int                 numConnectedArmbands() { return armbands.size(); }
+
+        // A single id across all hosts, host * idsPerHost + Myo id
+        static const int    idsPerHost = 1000;
+        static int          getGlobalId(const Armband* armband) { return armband->host * idsPerHost + armband->id; }
+        Armband*            getArmband(int globalId);
+
+        // Commands go to whichever host the armband belongs to
+        void                sendCommand(Armband* armband, string command, string type);
+        void                notifyUserAction(Armband* armband, string type = "single");
+        void                vibrate(Armband* armband, string type = "short");
+        void                requestSignalStrength(Armband* armband);
+        void                lock(Armband* armband);
+        void                unlock(Armband* armband, string type);
+        void                setStreamEmg(Armband* armband, bool enabled = true);
+
+        // The same events as Connection, merged from every host
+        ofEvent<Armband>    pairedEvent;
+        ofEvent<Armband>    unpairedEvent;
+        ofEvent<Armband>    connectedEvent;
+        ofEvent<Armband>    disconnectedEvent;
+        ofEvent<Armband>    armRecognizedEvent;
+        ofEvent<Armband>    armLostEvent;
+        ofEvent<Armband>    armSyncedEvent;
+        ofEvent<Armband>    armUnsyncedEvent;
+        ofEvent<Armband>    unlockedEvent;
+        ofEvent<Armband>    lockedEvent;
+        ofEvent<Armband>    poseStartedEvent;
+        ofEvent<Armband>    poseConfirmedEvent;
+        ofEvent<Armband>    poseSequenceEvent;
+        ofEvent<Armband>    orientationEvent;
+        ofEvent<Armband>    rssiReceivedEvent;
+
+    private:
+
+        struct Host {
+            string                      hostname;
+            int                         port;
+            std::unique_ptr<Connection> connection;
+        };
+
+        static bool         compareArmbands(const Armband* a, const Armband* b);
+
+        Connection*         getConnection(const Armband* armband);
+
+        void                addListeners(Connection& connection);
+        void                removeListeners(Connection& connection);
+
+        void                onPaired(Armband& armband) { ofNotifyEvent(pairedEvent, armband, this); }
+        void                onUnpaired(Armband& armband) { ofNotifyEvent(unpairedEvent, armband, this); }
+        void                onConnected(Armband& armband) { ofNotifyEvent(connectedEvent, armband, this); }
+        void                onDisconnected(Armband& armband) { ofNotifyEvent(disconnectedEvent, armband, this); }
+        void                onArmRecognized(Armband& armband) { ofNotifyEvent(armRecognizedEvent, armband, this); }
+        void                onArmLost(Armband& armband) { ofNotifyEvent(armLostEvent, armband, this); }
+        void                onArmSynced(Armband& armband) { ofNotifyEvent(armSyncedEvent, armband, this); }
+        void                onArmUnsynced(Armband& armband) { ofNotifyEvent(armUnsyncedEvent, armband, this); }
+        void                onUnlocked(Armband& armband) { ofNotifyEvent(unlockedEvent, armband, this); }
+        void                onLocked(Armband& armband) { ofNotifyEvent(lockedEvent, armband, this); }
+        void                onPoseStarted(Armband& armband) { ofNotifyEvent(poseStartedEvent, armband, this); }
+        void                onPoseConfirmed(Armband& armband) { ofNotifyEvent(poseConfirmedEvent, armband, this); }
+        void                onPoseSequence(Armband& armband) { ofNotifyEvent(poseSequenceEvent, armband, this); }
+        void                onOrientation(Armband& armband) { ofNotifyEvent(orientationEvent, armband, this); }
+        void                onRssiReceived(Armband& armband) { ofNotifyEvent(rssiReceivedEvent, armband, this); }
+
+        vector<Host>        hosts;
+
+    };
+
+}
@@ -0,0 +1,108 @@
+//
+//  ofxMyoWebSocketsImuHistory
+//
+
+#include "ofxMyoWebSocketsImuHistory.h"
+
+using namespace ofxMyoWebSockets;
+
+//--------------------------------------------------------------
+uint64_t ImuSamples::timestamp(int i) const{
+    return history->timestamps[index(i)];
+}
+
+//--------------------------------------------------------------
+float ImuSamples::accel(int i, int axis) const{
+    return history->accel[axis][index(i)];
+}
+
+//--------------------------------------------------------------
+float ImuSamples::gyro(int i, int axis) const{
+    return history->gyro[axis][index(i)];
+}
+
+//--------------------------------------------------------------
+float ImuSamples::quat(int i, int component) const{
+    return history->quat[component][index(i)];
+}
+
+//--------------------------------------------------------------
+bool ImuSamples::isValid() const{
+    return history && RingWindow::isValid(history->written);
+}
+
+//--------------------------------------------------------------
+ImuHistory::ImuHistory(){
+    written = 0;
+    oldest = 0;
+    setCapacity(256);
+}
+
+//--------------------------------------------------------------
+void ImuHistory::setCapacity(int capacity){
+
+    int size = 1;
+    while (size < capacity) size <<= 1;
+
+    timestamps.assign(size, 0);
+    for (int i = 0; i < 3; i++) accel[i].assign(size, 0);
+    for (int i = 0; i < 3; i++) gyro[i].assign(size, 0);
+    for (int i = 0; i < 4; i++) quat[i].assign(size, 0);
+
+    mask = size - 1;
+    written = 0;
+    oldest = 0;
+
+}
+
+//--------------------------------------------------------------
+void ImuHistory::clear(){
+    oldest.store(written.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+//--------------------------------------------------------------
+void ImuHistory::push(uint64_t timestamp, const float accel[3], const float gyro[3], const float quat[4]){
+
+    unsigned int sequence = written.load(std::memory_order_relaxed);
+    unsigned int i = sequence & mask;
+
+    timestamps[i] = timestamp;
+
+    this->accel[0][i] = accel[0];
+    this->accel[1][i] = accel[1];
+    this->accel[2][i] = accel[2];
+
+    this->gyro[0][i] = gyro[0];
+    this->gyro[1][i] = gyro[1];
+    this->gyro[2][i] = gyro[2];
+
+    this->quat[0][i] = quat[0];
+    this->quat[1][i] = quat[1];
+    this->quat[2][i] = quat[2];
+    this->quat[3][i] = quat[3];
+
+    written.store(sequence + 1, std::memory_order_release);
+
+}
+
+//--------------------------------------------------------------
+ImuSamples ImuHistory::getAll() const{
+    unsigned int end = written.load(std::memory_order_acquire);
+    return ImuSamples(this, RingWindow::getReadable(mask, oldest.load(std::memory_order_acquire), end));
+}
+
+//--------------------------------------------------------------
+ImuSamples ImuHistory::getLast(int count) const{
+    return ImuSamples(this, getAll().getLast(count));
+}
+
+//--------------------------------------------------------------
+ImuSamples ImuHistory::getSince(uint64_t timestamp) const{
+    const uint64_t* timestamps = getTimestamps();
+    return ImuSamples(this, getAll().getSince(timestamp, [timestamps](int slot){ return timestamps[slot]; }));
+}
+
+//--------------------------------------------------------------
+ImuSamples ImuHistory::getFrom(unsigned int sequence) const{
+    return ImuSamples(this, getAll().getFrom(sequence));
+}
@@ -0,0 +1,95 @@
+//
+//  ofxMyoWebSocketsImuHistory
+//
+//  Fixed-size ring buffer of timestamped accelerometer, gyroscope and
+//  orientation samples, stored as one array per component so windows of
+//  data can be processed in bulk. Written by the socket thread, readable
+//  from any other thread without locking or copying.
+//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ofxMyoWebSocketsRing.h"
+
+namespace ofxMyoWebSockets {
+
+    class ImuHistory;
+
+    // A window of samples, oldest first. This doesn't copy anything, it
+    // refers back into the history, so check isValid() if you hold on to
+    // it for a while. first, count, index(), getRuns() etc. come from
+    // RingWindow.
+    struct ImuSamples : RingWindow {
+
+        const ImuHistory*   history;
+
+        ImuSamples() : history(NULL) {}
+        ImuSamples(const ImuHistory* history, const RingWindow& window) : RingWindow(window), history(history) {}
+
+        uint64_t    timestamp(int i) const;
+        float       accel(int i, int axis) const;
+        float       gyro(int i, int axis) const;
+        float       quat(int i, int component) const; // x, y, z, w
+
+        // False once the oldest sample has been (or is being) overwritten
+        bool        isValid() const;
+
+    };
+
+    class ImuHistory {
+
+    public:
+
+        ImuHistory();
+
+        // Rounded up to a power of two. Not thread safe, call before use.
+        void        setCapacity(int capacity);
+        int         getCapacity() const { return timestamps.size(); }
+
+        // Only the newest 3/4 of the buffer is handed out to readers. The
+        // rest is headroom, so windows stay valid for a while as new
+        // samples keep coming in (about 1.3s for 256 samples at 50Hz).
+        int         getReadableCapacity() const { return RingWindow::getReadableCapacity(mask); }
+
+        // Writer side
+        void        clear();
+        void        push(uint64_t timestamp, const float accel[3], const float gyro[3], const float quat[4]);
+
+        // Reader side
+        ImuSamples  getAll() const;
+        ImuSamples  getLast(int count) const;
+        ImuSamples  getSince(uint64_t timestamp) const; // strictly newer than timestamp
+        ImuSamples  getFrom(unsigned int sequence) const; // e.g. the end() of an earlier window
+
+        // Total number of samples ever pushed, handy to see if anything new
+        // has come in
+        unsigned int getSampleCount() const { return written.load(std::memory_order_acquire); }
+
+        // Raw storage, indexed through ImuSamples::index() or getRuns()
+        const uint64_t* getTimestamps() const { return &timestamps[0]; }
+        const float*    getAccel(int axis) const { return &accel[axis][0]; }
+        const float*    getGyro(int axis) const { return &gyro[axis][0]; }
+        const float*    getQuat(int component) const { return &quat[component][0]; }
+
+    private:
+
+        friend struct ImuSamples;
+
+        std::vector<uint64_t>       timestamps;
+        std::vector<float>          accel[3];
+        std::vector<float>          gyro[3];
+        std::vector<float>          quat[4];
+
+        unsigned int                mask;
+
+        std::atomic<uint32_t>       written;    // sequence number of the next sample
+        std::atomic<unsigned int>   oldest;     // nothing before this is readable (clear())
+
+    };
+
+}
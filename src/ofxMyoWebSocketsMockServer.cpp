@@ -0,0 +1,457 @@
+//
+//  ofxMyoWebSocketsMockServer
+//
+
+#include "ofxMyoWebSocketsMockServer.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    // the poses a simulated armband cycles through, resting in between
+    const char* poseNames[] = { "rest", "fist", "wave_in", "wave_out", "fingers_spread", "double_tap" };
+    const int numPoses = sizeof(poseNames) / sizeof(poseNames[0]);
+
+    // simulated arm movement, radians per second
+    const float angularSpeed = 0.5f;
+
+}
+
+//--------------------------------------------------------------
+MockServer::MockServer(){
+
+    orientationRate = 50.0f;
+    poseRate = 0.5f;
+    rssiRate = 0.2f;
+    emgRate = 200.0f;
+
+    startTime = getTimestamp();
+
+    clients = 0;
+    sent = 0;
+    commands = 0;
+
+    setNumArmbands(1);
+
+}
+
+//--------------------------------------------------------------
+MockServer::~MockServer(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool MockServer::setup(int port){
+
+    ofxLibwebsockets::ServerOptions options = ofxLibwebsockets::defaultServerOptions();
+    options.port = port;
+
+    if (!server.setup(options)) {
+        ofLogError("ofxMyoWebSockets") << "Mock server couldn't listen on port " << port;
+        return false;
+    }
+
+    server.addListener(this);
+    startThread();
+
+    return true;
+
+}
+
+//--------------------------------------------------------------
+void MockServer::close(){
+
+    waitForThread(true);
+
+    server.removeListener(this);
+    server.close();
+
+}
+
+//--------------------------------------------------------------
+void MockServer::setNumArmbands(int count){
+
+    lock();
+
+    uint64_t now = getTimestamp();
+    armbands.resize(MAX(count, 0));
+
+    for (int i = 0; i < armbands.size(); i++) {
+        SimulatedArmband& armband = armbands[i];
+        armband.id = i;
+        armband.unlocked = false;
+        armband.pose = 0;
+        armband.phase = i * 0.7f;
+        armband.emg = false;
+
+        // stagger the streams so every band doesn't send at the same instant
+        armband.nextOrientation = now + i * interval(orientationRate) / MAX(count, 1);
+        armband.nextPose = now + interval(poseRate);
+        armband.nextRssi = now + interval(rssiRate);
+        armband.nextEmg = now;
+    }
+
+    unlock();
+
+}
+
+//--------------------------------------------------------------
+void MockServer::setOrientationRate(float hz){
+
+    lock();
+
+    orientationRate = hz;
+
+    // don't wait out the old interval
+    uint64_t next = getTimestamp() + interval(hz);
+    for (int i = 0; i < armbands.size(); i++) {
+        armbands[i].nextOrientation = MIN(armbands[i].nextOrientation, next);
+    }
+
+    unlock();
+
+}
+
+//--------------------------------------------------------------
+void MockServer::setPoseRate(float hz){
+
+    lock();
+
+    poseRate = hz;
+
+    // don't wait out the old interval
+    uint64_t next = getTimestamp() + interval(hz);
+    for (int i = 0; i < armbands.size(); i++) {
+        armbands[i].nextPose = MIN(armbands[i].nextPose, next);
+    }
+
+    unlock();
+
+}
+
+//--------------------------------------------------------------
+void MockServer::setRssiRate(float hz){
+
+    lock();
+
+    rssiRate = hz;
+
+    // don't wait out the old interval
+    uint64_t next = getTimestamp() + interval(hz);
+    for (int i = 0; i < armbands.size(); i++) {
+        armbands[i].nextRssi = MIN(armbands[i].nextRssi, next);
+    }
+
+    unlock();
+
+}
+
+//--------------------------------------------------------------
+void MockServer::setEmgRate(float hz){
+
+    lock();
+
+    emgRate = hz;
+
+    // don't wait out the old interval
+    uint64_t next = getTimestamp() + interval(hz);
+    for (int i = 0; i < armbands.size(); i++) {
+        armbands[i].nextEmg = MIN(armbands[i].nextEmg, next);
+    }
+
+    unlock();
+
+}
+
+//--------------------------------------------------------------
+void MockServer::simulatePose(int id, string pose){
+
+    char message[256];
+    snprintf(message, sizeof(message),
+        "[\"event\",{\"type\":\"pose\",\"timestamp\":\"%llu\",\"myo\":%d,\"pose\":\"%s\"}]",
+        (unsigned long long)getTimestamp(), id, pose.substr(0, 64).c_str());
+
+    lock();
+
+    // the armband's own poses and EMG carry on from this one
+    for (int i = 0; i < armbands.size(); i++) {
+        if (armbands[i].id != id) continue;
+        for (int j = 0; j < numPoses; j++) {
+            if (pose == poseNames[j]) armbands[i].pose = j;
+        }
+    }
+
+    send(message);
+
+    unlock();
+
+}
+
+//--------------------------------------------------------------
+uint64_t MockServer::getTimestamp(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//--------------------------------------------------------------
+uint64_t MockServer::interval(float hz){
+    return hz > 0 ? (uint64_t)(1000000.0f / hz) : 0;
+}
+
+//--------------------------------------------------------------
+void MockServer::threadedFunction(){
+
+    while (isThreadRunning()) {
+
+        uint64_t now = getTimestamp();
+        uint64_t next = now + 10000;
+
+        lock();
+
+        for (int i = 0; i < armbands.size(); i++) {
+
+            SimulatedArmband& armband = armbands[i];
+
+            // if we've fallen behind, skip ahead instead of bursting
+            if (orientationRate > 0 && now >= armband.nextOrientation) {
+                if (clients > 0) sendOrientation(armband, now);
+                armband.nextOrientation += interval(orientationRate);
+                if (armband.nextOrientation < now) armband.nextOrientation = now + interval(orientationRate);
+            }
+
+            if (poseRate > 0 && now >= armband.nextPose) {
+                if (clients > 0) sendPose(armband, now);
+                armband.nextPose = now + interval(poseRate);
+            }
+
+            if (rssiRate > 0 && now >= armband.nextRssi) {
+                if (clients > 0) sendRssi(armband.id, now);
+                armband.nextRssi = now + interval(rssiRate);
+            }
+
+            bool emg = armband.emg && emgRate > 0;
+
+            if (emg && now >= armband.nextEmg) {
+                if (clients > 0) sendEmg(armband, now);
+                armband.nextEmg += interval(emgRate);
+                if (armband.nextEmg < now) armband.nextEmg = now + interval(emgRate);
+            }
+
+            if (orientationRate > 0) next = MIN(next, armband.nextOrientation);
+            if (poseRate > 0) next = MIN(next, armband.nextPose);
+            if (rssiRate > 0) next = MIN(next, armband.nextRssi);
+            if (emg) next = MIN(next, armband.nextEmg);
+        }
+
+        unlock();
+
+        now = getTimestamp();
+        if (next > now) std::this_thread::sleep_for(std::chrono::microseconds(next - now));
+
+    }
+
+}
+
+//--------------------------------------------------------------
+void MockServer::send(const char* message){
+    server.send(message);
+    sent++;
+}
+
+//--------------------------------------------------------------
+void MockServer::sendOrientation(SimulatedArmband& armband, uint64_t now){
+
+    // slowly spin around the y axis
+    float angle = armband.phase + angularSpeed * ((now - startTime) / 1000000.0f);
+    float s = sin(angle * 0.5f);
+    float c = cos(angle * 0.5f);
+
+    char message[512];
+    snprintf(message, sizeof(message),
+        "[\"event\",{\"type\":\"orientation\",\"timestamp\":\"%llu\",\"myo\":%d,"
+        "\"orientation\":{\"x\":0,\"y\":%.6f,\"z\":0,\"w\":%.6f},"
+        "\"accelerometer\":[%.6f,0,%.6f],"
+        "\"gyroscope\":[0,%.4f,0]}]",
+        (unsigned long long)now, armband.id, s, c,
+        -sin(angle), cos(angle),
+        ofRadToDeg(angularSpeed));
+
+    send(message);
+
+}
+
+//--------------------------------------------------------------
+void MockServer::sendPose(SimulatedArmband& armband, uint64_t now){
+
+    // rest between every pose
+    armband.pose = armband.pose == 0 ? 1 + (int)ofRandom(numPoses - 1) : 0;
+    armband.pose = MIN(armband.pose, numPoses - 1);
+
+    char message[256];
+    snprintf(message, sizeof(message),
+        "[\"event\",{\"type\":\"pose\",\"timestamp\":\"%llu\",\"myo\":%d,\"pose\":\"%s\"}]",
+        (unsigned long long)now, armband.id, poseNames[armband.pose]);
+
+    send(message);
+
+}
+
+//--------------------------------------------------------------
+void MockServer::sendRssi(int id, uint64_t now){
+
+    char message[256];
+    snprintf(message, sizeof(message),
+        "[\"event\",{\"type\":\"rssi\",\"timestamp\":\"%llu\",\"myo\":%d,\"rssi\":%d}]",
+        (unsigned long long)now, id, (int)ofRandom(-70, -40));
+
+    send(message);
+
+}
+
+//--------------------------------------------------------------
+void MockServer::sendEmg(SimulatedArmband& armband, uint64_t now){
+
+    // noise, louder on a few sensors while a pose is held
+    int values[8];
+    for (int i = 0; i < 8; i++) {
+        float amplitude = armband.pose != 0 && (i + armband.pose) % 3 == 0 ? 100 : 10;
+        values[i] = (int)ofClamp(ofRandom(-amplitude, amplitude), -128, 127);
+    }
+
+    char message[256];
+    snprintf(message, sizeof(message),
+        "[\"event\",{\"type\":\"emg\",\"timestamp\":\"%llu\",\"myo\":%d,"
+        "\"emg\":[%d,%d,%d,%d,%d,%d,%d,%d]}]",
+        (unsigned long long)now, armband.id,
+        values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7]);
+
+    send(message);
+
+}
+
+//--------------------------------------------------------------
+void MockServer::sendLock(int id, bool unlocked, uint64_t now){
+
+    char message[256];
+    snprintf(message, sizeof(message),
+        "[\"event\",{\"type\":\"%s\",\"timestamp\":\"%llu\",\"myo\":%d}]",
+        unlocked ? "unlocked" : "locked", (unsigned long long)now, id);
+
+    send(message);
+
+}
+
+//--------------------------------------------------------------
+void MockServer::sendArmbands(ofxLibwebsockets::Connection& connection){
+
+    lock();
+
+    for (int i = 0; i < armbands.size(); i++) {
+
+        int id = armbands[i].id;
+        unsigned long long now = getTimestamp();
+        char message[320];
+
+        snprintf(message, sizeof(message),
+            "[\"event\",{\"type\":\"paired\",\"timestamp\":\"%llu\",\"myo\":%d,"
+            "\"mac_address\":\"00-00-00-00-00-%02x\",\"name\":\"Mock Myo %d\",\"firmware_version\":[1,5,1970,2]}]",
+            now, id, id & 0xFF, id);
+        connection.send(message);
+
+        snprintf(message, sizeof(message),
+            "[\"event\",{\"type\":\"connected\",\"timestamp\":\"%llu\",\"myo\":%d,\"version\":[1,5,1970,2]}]",
+            now, id);
+        connection.send(message);
+
+        snprintf(message, sizeof(message),
+            "[\"event\",{\"type\":\"arm_synced\",\"timestamp\":\"%llu\",\"myo\":%d,\"arm\":\"%s\","
+            "\"x_direction\":\"toward_wrist\",\"warmup_state\":\"warm\"}]",
+            now, id, id % 2 ? "left" : "right");
+        connection.send(message);
+
+        sent += 3;
+    }
+
+    unlock();
+
+}
+
+//--------------------------------------------------------------
+void MockServer::onConnect( ofxLibwebsockets::Event& args ){
+}
+
+//--------------------------------------------------------------
+void MockServer::onOpen( ofxLibwebsockets::Event& args ){
+    ofLogNotice("ofxMyoWebSockets") << "Mock server: client connected from " << args.conn.getClientIP();
+    sendArmbands(args.conn);
+    clients++;
+}
+
+//--------------------------------------------------------------
+void MockServer::onClose( ofxLibwebsockets::Event& args ){
+    ofLogNotice("ofxMyoWebSockets") << "Mock server: client disconnected";
+    if (clients > 0) clients--;
+}
+
+//--------------------------------------------------------------
+void MockServer::onIdle( ofxLibwebsockets::Event& args ){
+}
+
+//--------------------------------------------------------------
+void MockServer::onMessage( ofxLibwebsockets::Event& args ){
+
+    // ["command", {"command": "vibrate", "myo": 0, "type": "short"}]
+    if (!args.json.isArray() || args.json[0].asString() != "command") return;
+
+    Json::Value data = args.json[1];
+    string command = data["command"].asString();
+    int id = data.get("myo", -1).asInt();
+
+    commands++;
+
+    uint64_t now = getTimestamp();
+
+    lock();
+
+    for (int i = 0; i < armbands.size(); i++) {
+
+        SimulatedArmband& armband = armbands[i];
+        if (id != -1 && armband.id != id) continue;
+
+        if (command == "request_rssi") {
+            sendRssi(armband.id, now);
+        }
+        else if (command == "unlock" && !armband.unlocked) {
+            armband.unlocked = true;
+            sendLock(armband.id, true, now);
+        }
+        else if (command == "lock" && armband.unlocked) {
+            armband.unlocked = false;
+            sendLock(armband.id, false, now);
+        }
+        else if (command == "set_stream_emg") {
+            armband.emg = data["type"].asString() == "enabled";
+            armband.nextEmg = now;
+        }
+
+        // vibrate, notify_user_action, set_locking_policy etc. have nothing
+        // to simulate beyond the acknowledgement
+    }
+
+    unlock();
+
+    char message[256];
+    snprintf(message, sizeof(message),
+        "[\"acknowledgement\",{\"command\":\"%s\",\"success\":true}]", command.substr(0, 64).c_str());
+
+    args.conn.send(message);
+    sent++;
+
+}
+
+//--------------------------------------------------------------
+void MockServer::onBroadcast( ofxLibwebsockets::Event& args ){
+}
@@ -0,0 +1,114 @@
+//
+//  ofxMyoWebSocketsMockServer
+//
+//  Stand-in for Myo Connect's WebSocket server, for testing and load
+//  testing without any armbands. Simulates any number of armbands which
+//  pair, connect, sync and then stream orientation, pose and RSSI events at
+//  configurable rates, and answers commands sent by a Connection. EMG is
+//  streamed too, once a client asks for it with set_stream_emg.
+//
+//  Timestamps in the simulated events are in microseconds from
+//  MockServer::getTimestamp(), a system-wide monotonic clock, so clients on
+//  the same machine can work out their end-to-end latency by comparing
+//  Armband::timestamp against it.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxLibwebsockets.h"
+
+namespace ofxMyoWebSockets {
+
+    class MockServer : public ofThread {
+
+    public:
+
+        MockServer();
+        ~MockServer();
+
+        bool            setup(int port = 10138);
+        void            close();
+
+        // Number of simulated armbands, 1 by default
+        void            setNumArmbands(int count);
+
+        // Events per second, per armband. Myo Connect streams orientation at
+        // 50Hz. Pass 0 to turn a stream off.
+        void            setOrientationRate(float hz = 50.0f);
+        void            setPoseRate(float hz = 0.5f);
+        void            setRssiRate(float hz = 0.2f);
+
+        // Myo Connect streams EMG at 200Hz, when it's turned on
+        void            setEmgRate(float hz = 200.0f);
+
+        // Sends a pose for one of the simulated armbands right away, e.g.
+        // for scripted tests with setPoseRate(0)
+        void            simulatePose(int id, string pose);
+
+        unsigned int    getNumClients() { return clients; }
+        unsigned int    getSentCount() { return sent; }
+        unsigned int    getCommandCount() { return commands; }
+
+        // Microseconds from a monotonic clock shared by every process on the
+        // machine (std::chrono::steady_clock)
+        static uint64_t getTimestamp();
+
+        // ofxLibwebsockets callbacks
+        void onConnect( ofxLibwebsockets::Event& args );
+        void onOpen( ofxLibwebsockets::Event& args );
+        void onClose( ofxLibwebsockets::Event& args );
+        void onIdle( ofxLibwebsockets::Event& args );
+        void onMessage( ofxLibwebsockets::Event& args );
+        void onBroadcast( ofxLibwebsockets::Event& args );
+
+        void threadedFunction();
+
+        ofxLibwebsockets::Server    server;
+
+    private:
+
+        struct SimulatedArmband {
+
+            int         id;
+            bool        unlocked;
+            int         pose;       // index into the pose names
+            float       phase;      // so the bands don't all move in sync
+            bool        emg;        // set_stream_emg
+
+            uint64_t    nextOrientation;
+            uint64_t    nextPose;
+            uint64_t    nextRssi;
+            uint64_t    nextEmg;
+
+        };
+
+        void            sendOrientation(SimulatedArmband& armband, uint64_t now);
+        void            sendPose(SimulatedArmband& armband, uint64_t now);
+        void            sendRssi(int id, uint64_t now);
+        void            sendEmg(SimulatedArmband& armband, uint64_t now);
+        void            sendLock(int id, bool unlocked, uint64_t now);
+
+        // Events for a client which just connected, as if the armbands had
+        // just been paired and synced
+        void            sendArmbands(ofxLibwebsockets::Connection& connection);
+
+        void            send(const char* message);
+
+        static uint64_t interval(float hz);
+
+        vector<SimulatedArmband>    armbands;
+        uint64_t                    startTime;
+
+        float                       orientationRate;
+        float                       poseRate;
+        float                       rssiRate;
+        float                       emgRate;
+
+        std::atomic<unsigned int>   clients;
+        std::atomic<unsigned int>   sent;
+        std::atomic<unsigned int>   commands;
+
+    };
+
+}
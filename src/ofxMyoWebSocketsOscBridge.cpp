@@ -0,0 +1,263 @@
+//
+//  ofxMyoWebSocketsOscBridge
+//
+
+#include "ofxMyoWebSocketsOscBridge.h"
+#include "ofxMyoWebSockets.h"
+
+using namespace ofxMyoWebSockets;
+
+//--------------------------------------------------------------
+OscWriter::OscWriter(int capacity){
+    buffer.resize(MAX(capacity, 64));
+    clear();
+}
+
+//--------------------------------------------------------------
+void OscWriter::clear(){
+    size = 0;
+    messageStart = 0;
+    messageFailed = false;
+    bundle = false;
+    messages = 0;
+}
+
+//--------------------------------------------------------------
+void OscWriter::beginBundle(){
+
+    clear();
+    writeString("#bundle");
+
+    // time tag 1 means immediately
+    writeInt32(0);
+    writeInt32(1);
+
+    bundle = true;
+
+}
+
+//--------------------------------------------------------------
+void OscWriter::beginMessage(const char* address, const char* types){
+
+    messageStart = size;
+    messageFailed = false;
+
+    // element size, filled in by endMessage()
+    if (bundle) writeInt32(0);
+
+    writeString(address);
+    writeString(types);
+
+}
+
+//--------------------------------------------------------------
+void OscWriter::addInt(int32_t value){
+    writeInt32(value);
+}
+
+//--------------------------------------------------------------
+void OscWriter::addFloat(float value){
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    writeInt32(bits);
+}
+
+//--------------------------------------------------------------
+void OscWriter::addString(const char* value){
+    writeString(value);
+}
+
+//--------------------------------------------------------------
+bool OscWriter::endMessage(){
+
+    if (messageFailed) {
+        size = messageStart;
+        messageFailed = false;
+        return false;
+    }
+
+    if (bundle) {
+        uint32_t length = size - messageStart - 4;
+        char* prefix = &buffer[messageStart];
+        prefix[0] = length >> 24;
+        prefix[1] = length >> 16;
+        prefix[2] = length >> 8;
+        prefix[3] = length;
+    }
+
+    messages++;
+    return true;
+
+}
+
+//--------------------------------------------------------------
+void OscWriter::write(const void* data, int length){
+
+    if (messageFailed || size + length > buffer.size()) {
+        messageFailed = true;
+        return;
+    }
+
+    memcpy(&buffer[size], data, length);
+    size += length;
+
+}
+
+//--------------------------------------------------------------
+void OscWriter::writeInt32(uint32_t value){
+    // big endian
+    char bytes[4] = { (char)(value >> 24), (char)(value >> 16), (char)(value >> 8), (char)value };
+    write(bytes, 4);
+}
+
+//--------------------------------------------------------------
+void OscWriter::writeString(const char* value){
+
+    // null terminated, padded out to a multiple of 4 bytes
+    int length = strlen(value);
+    write(value, length);
+
+    static const char zeros[4] = { 0, 0, 0, 0 };
+    write(zeros, 4 - length % 4);
+
+}
+
+//--------------------------------------------------------------
+OscBridge::OscBridge(){
+    connected = false;
+    interval = 20000;
+    lastOrientation = 0;
+    orientationDue = false;
+    sent = 0;
+    dropped = 0;
+}
+
+//--------------------------------------------------------------
+OscBridge::~OscBridge(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool OscBridge::setup(string host, int port, string prefix){
+
+    close();
+
+    orientationAddress = prefix + "/orientation";
+    poseAddress = prefix + "/pose";
+    unlockedAddress = prefix + "/unlocked";
+
+    // never hold up the socket thread, drop the bundle instead
+    if (!udp.Create() || !udp.Connect(host.c_str(), port) || !udp.SetNonBlocking(true)) {
+        ofLogError("ofxMyoWebSockets") << "Couldn't set up OSC to " << host << ":" << port;
+        udp.Close();
+        return false;
+    }
+
+    udp.SetEnableBroadcast(true);
+
+    connected = true;
+    return true;
+
+}
+
+//--------------------------------------------------------------
+void OscBridge::close(){
+
+    if (!connected) return;
+
+    udp.Close();
+    connected = false;
+    packet.clear();
+
+}
+
+//--------------------------------------------------------------
+void OscBridge::setInterval(float seconds){
+    interval = (uint64_t)(MAX(seconds, 0.0f) * 1000000);
+}
+
+//--------------------------------------------------------------
+bool OscBridge::isDue(uint64_t now){
+
+    if (!connected) return false;
+
+    orientationDue = now - lastOrientation >= interval;
+    return orientationDue || !packet.empty();
+
+}
+
+//--------------------------------------------------------------
+void OscBridge::addOrientation(const Armband& armband){
+
+    if (!connected || !orientationDue || armband.stale) return;
+    if (packet.getSize() == 0) packet.beginBundle();
+
+    const ofVec3f& euler = armband.getEulerAngles();
+
+    packet.beginMessage(orientationAddress.c_str(), ",ifffffffffffff");
+    packet.addInt(armband.id);
+    packet.addFloat(euler.x);
+    packet.addFloat(euler.y);
+    packet.addFloat(euler.z);
+    packet.addFloat(armband.quat.x());
+    packet.addFloat(armband.quat.y());
+    packet.addFloat(armband.quat.z());
+    packet.addFloat(armband.quat.w());
+    packet.addFloat(armband.accel.x);
+    packet.addFloat(armband.accel.y);
+    packet.addFloat(armband.accel.z);
+    packet.addFloat(armband.gyro.x);
+    packet.addFloat(armband.gyro.y);
+    packet.addFloat(armband.gyro.z);
+    if (!packet.endMessage()) dropped++;
+
+}
+
+//--------------------------------------------------------------
+void OscBridge::addPose(const Armband& armband, bool confirmed){
+
+    if (!connected) return;
+    if (packet.getSize() == 0) packet.beginBundle();
+
+    packet.beginMessage(poseAddress.c_str(), ",isi");
+    packet.addInt(armband.id);
+    packet.addString(toString(armband.pose));
+    packet.addInt(confirmed);
+    if (!packet.endMessage()) dropped++;
+
+}
+
+//--------------------------------------------------------------
+void OscBridge::addUnlocked(const Armband& armband){
+
+    if (!connected) return;
+    if (packet.getSize() == 0) packet.beginBundle();
+
+    packet.beginMessage(unlockedAddress.c_str(), ",ii");
+    packet.addInt(armband.id);
+    packet.addInt(armband.unlocked);
+    if (!packet.endMessage()) dropped++;
+
+}
+
+//--------------------------------------------------------------
+void OscBridge::send(uint64_t now){
+
+    if (!connected) return;
+
+    if (orientationDue) {
+        lastOrientation = now;
+        orientationDue = false;
+    }
+
+    if (packet.empty()) {
+        packet.clear();
+        return;
+    }
+
+    if (udp.Send(packet.getData(), packet.getSize()) == packet.getSize()) sent++;
+    else dropped += packet.getNumMessages();
+
+    packet.clear();
+
+}
@@ -0,0 +1,119 @@
+//
+//  ofxMyoWebSocketsOscBridge
+//
+//  Re-broadcasts armband data over OSC/UDP straight from the socket thread,
+//  for Max, TouchDesigner, other apps and the like. Everything that happens
+//  while a message is handled goes out as one bundle, with every armband's
+//  orientation in it whenever the interval has passed. Bundles are encoded
+//  into a buffer allocated once, up front.
+//
+//  Messages, with the default "/myo" prefix:
+//
+//      /myo/orientation    ,ifffffffffffff     id, roll, pitch, yaw,
+//                                              quat x, y, z, w,
+//                                              accel x, y, z, gyro x, y, z
+//      /myo/pose           ,isi                id, pose name, confirmed
+//      /myo/unlocked       ,ii                 id, unlocked
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxNetwork.h"
+
+namespace ofxMyoWebSockets {
+
+    struct Armband;
+
+    // Encodes OSC messages and bundles into a fixed-size buffer. A message
+    // that doesn't fit is dropped whole.
+    class OscWriter {
+
+    public:
+
+        OscWriter(int capacity = 8192);
+
+        void            clear();
+
+        // Everything from here until clear() goes in one bundle, to be
+        // handled immediately
+        void            beginBundle();
+
+        void            beginMessage(const char* address, const char* types);
+        void            addInt(int32_t value);
+        void            addFloat(float value);
+        void            addString(const char* value);
+
+        // Returns false if the message didn't fit
+        bool            endMessage();
+
+        bool            empty() const { return messages == 0; }
+        int             getNumMessages() const { return messages; }
+
+        const char*     getData() const { return &buffer[0]; }
+        int             getSize() const { return size; }
+
+    private:
+
+        void            write(const void* data, int length);
+        void            writeInt32(uint32_t value);
+        void            writeString(const char* value);
+
+        vector<char>    buffer;
+        int             size;
+        int             messageStart;
+        bool            messageFailed;
+        bool            bundle;
+        int             messages;
+
+    };
+
+    class OscBridge {
+
+    public:
+
+        OscBridge();
+        ~OscBridge();
+
+        // e.g. "127.0.0.1" and 9000. prefix starts every address.
+        bool            setup(string host, int port, string prefix = "/myo");
+        void            close();
+        bool            isSetup() { return connected; }
+
+        // Orientation goes out for every armband at most this often, 0.02
+        // seconds (the IMU's 50Hz) by default, 0 for every sample. Poses
+        // and locking go out as soon as they happen.
+        void            setInterval(float seconds);
+
+        unsigned int    getSentCount() { return sent; }
+        unsigned int    getDroppedCount() { return dropped; }
+
+        // Called by Connection on the socket thread. Orientation is only
+        // added while it's due.
+        bool            isDue(uint64_t now);
+        void            addOrientation(const Armband& armband);
+        void            addPose(const Armband& armband, bool confirmed);
+        void            addUnlocked(const Armband& armband);
+        void            send(uint64_t now);
+
+    private:
+
+        ofxUDPManager   udp;
+        bool            connected;
+
+        OscWriter       packet;
+
+        string          orientationAddress;
+        string          poseAddress;
+        string          unlockedAddress;
+
+        uint64_t        interval;       // microseconds
+        uint64_t        lastOrientation;
+        bool            orientationDue;
+
+        std::atomic<unsigned int>   sent;
+        std::atomic<unsigned int>   dropped;
+
+    };
+
+}
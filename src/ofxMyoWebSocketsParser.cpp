@@ -0,0 +1,417 @@
+//
+//  ofxMyoWebSocketsParser
+//
+//  Allocation-free decoders for the high-rate messages sent by Myo Connect.
+//
+
+#include "ofxMyoWebSocketsParser.h"
+
+#include <string.h>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    // Minimal forward-only JSON cursor. It only understands as much JSON as
+    // Myo Connect actually sends and bails out on everything else.
+    struct Cursor {
+
+        const char* p;
+        const char* end;
+
+        void skipWhitespace() {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+        }
+
+        bool expect(char c) {
+            skipWhitespace();
+            if (p >= end || *p != c) return false;
+            p++;
+            return true;
+        }
+
+        bool peek(char c) {
+            skipWhitespace();
+            return p < end && *p == c;
+        }
+
+        // Strings are returned as a pointer into the message. Escapes never
+        // show up in the keys or values we care about, so treat them as
+        // "unusual" and let the caller fall back.
+        bool string(const char*& start, size_t& length) {
+            if (!expect('"')) return false;
+            start = p;
+            while (p < end && *p != '"') {
+                if (*p == '\\') return false;
+                p++;
+            }
+            if (p >= end) return false;
+            length = p - start;
+            p++;
+            return true;
+        }
+
+        bool number(double& value) {
+
+            skipWhitespace();
+
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+')) {
+                negative = (*p == '-');
+                p++;
+            }
+
+            unsigned long long mantissa = 0;
+            int digits = 0;
+            int exponent = 0;
+
+            // integer part
+            const char* start = p;
+            while (p < end && *p >= '0' && *p <= '9') {
+                if (digits < 18) { mantissa = mantissa * 10 + (*p - '0'); digits++; }
+                else exponent++;
+                p++;
+            }
+
+            // fractional part
+            if (p < end && *p == '.') {
+                p++;
+                while (p < end && *p >= '0' && *p <= '9') {
+                    if (digits < 18) { mantissa = mantissa * 10 + (*p - '0'); digits++; exponent--; }
+                    p++;
+                }
+            }
+
+            if (p == start) return false;
+
+            // exponent
+            if (p < end && (*p == 'e' || *p == 'E')) {
+                p++;
+                bool negativeExponent = false;
+                if (p < end && (*p == '-' || *p == '+')) {
+                    negativeExponent = (*p == '-');
+                    p++;
+                }
+                int e = 0;
+                if (p >= end || *p < '0' || *p > '9') return false;
+                while (p < end && *p >= '0' && *p <= '9') {
+                    if (e < 1000) e = e * 10 + (*p - '0');
+                    p++;
+                }
+                exponent += negativeExponent ? -e : e;
+            }
+
+            static const double powers[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+
+            // way outside of anything a sensor reports
+            if (exponent > 22 || exponent < -22) return false;
+
+            value = (double)mantissa;
+            if (exponent < 0) value /= powers[-exponent];
+            else value *= powers[exponent];
+
+            if (negative) value = -value;
+            return true;
+
+        }
+
+        // Whole numbers only, e.g. EMG values, without going through
+        // doubles. Fractions and exponents aren't whole numbers.
+        bool integer(int& value) {
+
+            skipWhitespace();
+
+            bool negative = false;
+            if (p < end && *p == '-') {
+                negative = true;
+                p++;
+            }
+
+            const char* start = p;
+            int result = 0;
+            while (p < end && *p >= '0' && *p <= '9' && p - start < 9) {
+                result = result * 10 + (*p - '0');
+                p++;
+            }
+
+            if (p == start) return false;
+            if (p < end && ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E')) return false;
+
+            value = negative ? -result : result;
+            return true;
+
+        }
+
+        bool number(float& value) {
+            double d;
+            if (!number(d)) return false;
+            value = (float)d;
+            return true;
+        }
+
+        bool number(int& value) {
+            double d;
+            if (!number(d)) return false;
+            value = (int)d;
+            return true;
+        }
+
+        // Skip over any value we don't care about (e.g. "warmup_state")
+        bool skipValue() {
+
+            skipWhitespace();
+            if (p >= end) return false;
+
+            if (*p == '"') {
+                const char* s; size_t l;
+                return string(s, l);
+            }
+
+            if (*p == '{' || *p == '[') {
+                int depth = 0;
+                while (p < end) {
+                    char c = *p;
+                    if (c == '"') {
+                        const char* s; size_t l;
+                        if (!string(s, l)) return false;
+                        continue;
+                    }
+                    if (c == '{' || c == '[') depth++;
+                    if (c == '}' || c == ']') depth--;
+                    p++;
+                    if (depth == 0) return true;
+                }
+                return false;
+            }
+
+            // number, true, false, null
+            const char* start = p;
+            while (p < end && *p != ',' && *p != '}' && *p != ']' &&
+                   *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') p++;
+            return p != start;
+
+        }
+
+        bool array(float* values, int count) {
+            if (!expect('[')) return false;
+            for (int i = 0; i < count; i++) {
+                if (i > 0 && !expect(',')) return false;
+                if (!number(values[i])) return false;
+            }
+            return expect(']');
+        }
+
+        bool array(int8_t* values, int count) {
+            if (!expect('[')) return false;
+            for (int i = 0; i < count; i++) {
+                int value;
+                if (i > 0 && !expect(',')) return false;
+                if (!integer(value) || value < -128 || value > 127) return false;
+                values[i] = value;
+            }
+            return expect(']');
+        }
+
+    };
+
+    bool equals(const char* s, size_t length, const char* literal) {
+        return strlen(literal) == length && memcmp(s, literal, length) == 0;
+    }
+
+    // ["event", {
+    bool beginEvent(Cursor& c) {
+        const char* s; size_t l;
+        if (!c.expect('[')) return false;
+        if (!c.string(s, l) || !equals(s, l, "event")) return false;
+        return c.expect(',') && c.expect('{');
+    }
+
+    // }]
+    bool endEvent(Cursor& c) {
+        return c.expect('}') && c.expect(']');
+    }
+
+    bool parseQuaternion(Cursor& c, float* quat) {
+
+        if (!c.expect('{')) return false;
+
+        int found = 0;
+        bool first = true;
+
+        while (!c.peek('}')) {
+
+            if (!first && !c.expect(',')) return false;
+            first = false;
+
+            const char* key; size_t length;
+            if (!c.string(key, length) || !c.expect(':')) return false;
+
+            int index = -1;
+            if (length == 1) {
+                switch (key[0]) {
+                    case 'x': index = 0; break;
+                    case 'y': index = 1; break;
+                    case 'z': index = 2; break;
+                    case 'w': index = 3; break;
+                }
+            }
+
+            if (index < 0) {
+                if (!c.skipValue()) return false;
+                continue;
+            }
+
+            if (!c.number(quat[index])) return false;
+            found |= 1 << index;
+        }
+
+        c.expect('}');
+        return found == 0xF;
+
+    }
+
+}
+
+//--------------------------------------------------------------
+bool ofxMyoWebSockets::parseOrientation(const char* data, size_t length, OrientationFrame& frame){
+
+    enum {
+        FOUND_TYPE          = 1 << 0,
+        FOUND_MYO           = 1 << 1,
+        FOUND_ORIENTATION   = 1 << 2,
+        FOUND_ACCELEROMETER = 1 << 3,
+        FOUND_GYROSCOPE     = 1 << 4,
+        FOUND_ALL           = (1 << 5) - 1
+    };
+
+    Cursor c;
+    c.p = data;
+    c.end = data + length;
+
+    const char* s; size_t l;
+
+    if (!beginEvent(c)) return false;
+
+    int found = 0;
+    bool first = true;
+
+    frame.timestamp = 0;
+
+    while (!c.peek('}')) {
+
+        if (!first && !c.expect(',')) return false;
+        first = false;
+
+        const char* key; size_t keyLength;
+        if (!c.string(key, keyLength) || !c.expect(':')) return false;
+
+        if (equals(key, keyLength, "type")) {
+            // bail as early as possible on everything but orientation
+            if (!c.string(s, l) || !equals(s, l, "orientation")) return false;
+            found |= FOUND_TYPE;
+        }
+        else if (equals(key, keyLength, "timestamp") && c.peek('"')) {
+            if (!c.string(s, l)) return false;
+            frame.timestamp = parseTimestamp(s, l);
+        }
+        else if (equals(key, keyLength, "myo")) {
+            if (!c.number(frame.myo)) return false;
+            found |= FOUND_MYO;
+        }
+        else if (equals(key, keyLength, "orientation")) {
+            if (!parseQuaternion(c, frame.quat)) return false;
+            found |= FOUND_ORIENTATION;
+        }
+        else if (equals(key, keyLength, "accelerometer")) {
+            if (!c.array(frame.accel, 3)) return false;
+            found |= FOUND_ACCELEROMETER;
+        }
+        else if (equals(key, keyLength, "gyroscope")) {
+            if (!c.array(frame.gyro, 3)) return false;
+            found |= FOUND_GYROSCOPE;
+        }
+        else {
+            if (!c.skipValue()) return false;
+        }
+    }
+
+    if (!endEvent(c)) return false;
+
+    return found == FOUND_ALL;
+
+}
+
+//--------------------------------------------------------------
+bool ofxMyoWebSockets::parseEmg(const char* data, size_t length, EmgFrame& frame){
+
+    enum {
+        FOUND_TYPE          = 1 << 0,
+        FOUND_MYO           = 1 << 1,
+        FOUND_EMG           = 1 << 2,
+        FOUND_ALL           = (1 << 3) - 1
+    };
+
+    Cursor c;
+    c.p = data;
+    c.end = data + length;
+
+    const char* s; size_t l;
+
+    if (!beginEvent(c)) return false;
+
+    int found = 0;
+    bool first = true;
+
+    frame.timestamp = 0;
+
+    while (!c.peek('}')) {
+
+        if (!first && !c.expect(',')) return false;
+        first = false;
+
+        const char* key; size_t keyLength;
+        if (!c.string(key, keyLength) || !c.expect(':')) return false;
+
+        if (equals(key, keyLength, "type")) {
+            if (!c.string(s, l) || !equals(s, l, "emg")) return false;
+            found |= FOUND_TYPE;
+        }
+        else if (equals(key, keyLength, "timestamp") && c.peek('"')) {
+            if (!c.string(s, l)) return false;
+            frame.timestamp = parseTimestamp(s, l);
+        }
+        else if (equals(key, keyLength, "myo")) {
+            if (!c.integer(frame.myo)) return false;
+            found |= FOUND_MYO;
+        }
+        else if (equals(key, keyLength, "emg")) {
+            if (!c.array(frame.emg, 8)) return false;
+            found |= FOUND_EMG;
+        }
+        else {
+            if (!c.skipValue()) return false;
+        }
+    }
+
+    if (!endEvent(c)) return false;
+
+    return found == FOUND_ALL;
+
+}
+
+//--------------------------------------------------------------
+uint64_t ofxMyoWebSockets::parseTimestamp(const char* data, size_t length){
+
+    uint64_t timestamp = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        if (data[i] < '0' || data[i] > '9') return 0;
+        timestamp = timestamp * 10 + (data[i] - '0');
+    }
+
+    return timestamp;
+
+}
@@ -0,0 +1,51 @@
+//
+//  ofxMyoWebSocketsParser
+//
+//  Allocation-free decoders for the high-rate messages sent by Myo Connect.
+//  Anything these don't recognize should be handed to the regular ofxJSON path.
+//
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ofxMyoWebSockets {
+
+    struct OrientationFrame {
+
+        int         myo;
+        uint64_t    timestamp;  // as sent by Myo Connect, 0 if missing
+
+        float       accel[3];
+        float       gyro[3];
+        float       quat[4];    // x, y, z, w
+
+    };
+
+    struct EmgFrame {
+
+        int         myo;
+        uint64_t    timestamp;  // as sent by Myo Connect, 0 if missing
+
+        int8_t      emg[8];     // one per sensor
+
+    };
+
+    // Decodes ["event",{"type":"orientation","myo":..,"orientation":{..},
+    // "accelerometer":[..],"gyroscope":[..]}] straight from the raw message
+    // bytes. Returns false (and leaves frame in an undefined state) for any
+    // other event type, or for anything it doesn't understand, e.g. escaped
+    // strings or missing fields.
+    bool parseOrientation(const char* data, size_t length, OrientationFrame& frame);
+
+    // Decodes ["event",{"type":"emg","myo":..,"emg":[..]}] the same way.
+    // Sent at 200Hz per armband once streaming is turned on, so this only
+    // reads whole numbers and gives up on anything else.
+    bool parseEmg(const char* data, size_t length, EmgFrame& frame);
+
+    // Myo Connect sends timestamps as strings of microseconds. Returns 0 if
+    // it isn't one.
+    uint64_t parseTimestamp(const char* data, size_t length);
+
+}
@@ -0,0 +1,115 @@
+//
+//  ofxMyoWebSocketsPolicies
+//
+//  Compile-time choices for BasicConnection. Connection (DefaultPolicies)
+//  decides everything at runtime, as it always has. Fixing some of it at
+//  compile time means the paths you don't use are never compiled in, e.g.
+//
+//      struct MyPolicies : ofxMyoWebSockets::DefaultPolicies {
+//          typedef ofxMyoWebSockets::Radians           Units;
+//          typedef ofxMyoWebSockets::ImmediateDispatch Dispatch;
+//          typedef ofxMyoWebSockets::NoLocking         Locking;
+//          typedef ofxMyoWebSockets::LazyDerived       Derived;
+//      };
+//
+//      ofxMyoWebSockets::BasicConnection<MyPolicies> myo;
+//
+//  The matching setters (setUseDegrees() etc.) log a warning if asked for
+//  something the policy rules out.
+//
+
+#pragma once
+
+namespace ofxMyoWebSockets {
+
+    //
+    // Units of Armband::roll, pitch & yaw
+    //
+
+    // setUseDegrees() decides, radians until then
+    struct RuntimeUnits {
+        RuntimeUnits() : degrees(false) {}
+        bool            useDegrees() const { return degrees; }
+        bool            setUseDegrees(bool degrees) { this->degrees = degrees; return true; }
+        bool            degrees;
+    };
+
+    struct Radians {
+        static bool     useDegrees() { return false; }
+        static bool     setUseDegrees(bool degrees) { return !degrees; }
+    };
+
+    struct Degrees {
+        static bool     useDegrees() { return true; }
+        static bool     setUseDegrees(bool degrees) { return degrees; }
+    };
+
+    //
+    // Where events are fired from. Events nobody listens to are skipped
+    // either way. When they aren't queued, pose confirmations and locks
+    // which wait on a deadline (a minimum gesture duration, the unlock
+    // timeout) come from the scheduler's thread, right at the deadline.
+    //
+
+    // setQueuedEvents() decides, straight from the socket thread until then
+    struct RuntimeDispatch {
+        RuntimeDispatch() : queued(false) {}
+        bool            isQueued() const { return queued; }
+        bool            setQueued(bool queued) { this->queued = queued; return true; }
+        bool            queued;
+    };
+
+    // Straight from the socket (or scheduler's) thread, no queue
+    struct ImmediateDispatch {
+        static bool     isQueued() { return false; }
+        static bool     setQueued(bool queued) { return !queued; }
+    };
+
+    // Always from update() on the main thread
+    struct QueuedDispatch {
+        static bool     isQueued() { return true; }
+        static bool     setQueued(bool queued) { return queued; }
+    };
+
+    //
+    // Pose confirmation & locking
+    //
+
+    // GesturePolicy's state machine: minimum gesture durations, unlocking,
+    // automatic locking, sequences, with a scheduler thread for the timing
+    struct GestureLocking {
+        static const bool   enabled = true;
+    };
+
+    // None of that. Poses are confirmed as soon as they start, locked &
+    // unlocked come straight from Myo Connect, the armband is never
+    // vibrated, and there's no scheduler thread.
+    struct NoLocking {
+        static const bool   enabled = false;
+    };
+
+    //
+    // Data derived from orientation
+    //
+
+    // Armband::roll, pitch & yaw are worked out for every armband in
+    // update(), for every queued orientation event, and before any event
+    // fired straight from the socket thread
+    struct EagerDerived {
+        static const bool   eager = true;
+    };
+
+    // Only worked out when asked for, with getRoll(), getEulerAngles() etc.
+    // The roll, pitch & yaw fields stay at 0.
+    struct LazyDerived {
+        static const bool   eager = false;
+    };
+
+    struct DefaultPolicies {
+        typedef RuntimeUnits        Units;
+        typedef RuntimeDispatch     Dispatch;
+        typedef GestureLocking      Locking;
+        typedef EagerDerived        Derived;
+    };
+
+}
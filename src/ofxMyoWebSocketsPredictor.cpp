@@ -0,0 +1,218 @@
+//
+//  ofxMyoWebSocketsPredictor
+//
+
+#include "ofxMyoWebSocketsPredictor.h"
+
+#include <math.h>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    const float pi = 3.14159265358979f;
+    const float degToRad = pi / 180.0f;
+
+    // One Euro filter's cutoff for the angular speed itself, in Hz
+    const float speedCutoff = 1.0f;
+
+    // How fast the offset between Myo Connect's clock and ours may grow,
+    // in seconds per second
+    const float offsetCreep = 0.01f;
+
+    // After a gap this long, in microseconds, Myo Connect's clock is
+    // mapped onto ours from scratch
+    const uint64_t offsetResetGap = 1000000;
+
+    //--------------------------------------------------------------
+    float getSmoothing(float cutoff, float dt){
+        float tau = 1.0f / (2.0f * pi * cutoff);
+        return 1.0f / (1.0f + tau / dt);
+    }
+
+    //--------------------------------------------------------------
+    void normalize(float q[4]){
+
+        float length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        if (length <= 0) {
+            q[0] = q[1] = q[2] = 0;
+            q[3] = 1;
+            return;
+        }
+
+        for (int i = 0; i < 4; i++) q[i] /= length;
+
+    }
+
+    //--------------------------------------------------------------
+    // a then b, both x, y, z, w
+    void multiply(const float a[4], const float b[4], float result[4]){
+        result[0] = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+        result[1] = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+        result[2] = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+        result[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+    }
+
+    //--------------------------------------------------------------
+    // q turned by angular velocity gyro (rad/s, in q's own frame) for dt
+    // seconds
+    void integrate(const float q[4], const float gyro[3], float dt, float result[4]){
+
+        float speed = sqrtf(gyro[0] * gyro[0] + gyro[1] * gyro[1] + gyro[2] * gyro[2]);
+        float angle = speed * dt;
+
+        float delta[4];
+        if (fabsf(angle) < 1e-6f) {
+            delta[0] = gyro[0] * dt * 0.5f;
+            delta[1] = gyro[1] * dt * 0.5f;
+            delta[2] = gyro[2] * dt * 0.5f;
+            delta[3] = 1;
+        } else {
+            float s = sinf(angle * 0.5f) / speed;
+            delta[0] = gyro[0] * s;
+            delta[1] = gyro[1] * s;
+            delta[2] = gyro[2] * s;
+            delta[3] = cosf(angle * 0.5f);
+        }
+
+        multiply(q, delta, result);
+        normalize(result);
+
+    }
+
+    //--------------------------------------------------------------
+    void slerp(const float a[4], const float b[4], float t, float result[4]){
+
+        // the short way round
+        float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        float sign = 1;
+        if (dot < 0) {
+            dot = -dot;
+            sign = -1;
+        }
+
+        float wa = 1 - t;
+        float wb = t;
+
+        // close enough to lerp
+        if (dot < 0.9995f) {
+            float theta = acosf(dot);
+            float s = sinf(theta);
+            wa = sinf((1 - t) * theta) / s;
+            wb = sinf(t * theta) / s;
+        }
+
+        for (int i = 0; i < 4; i++) result[i] = wa * a[i] + sign * wb * b[i];
+        normalize(result);
+
+    }
+
+}
+
+//--------------------------------------------------------------
+void Motion::predict(uint64_t time, float result[4]) const{
+
+    if (!valid) {
+        for (int i = 0; i < 4; i++) result[i] = quat[i];
+        return;
+    }
+
+    float dt = (int64_t)(time - this->time) / 1000000.0f;
+    if (dt > maxPrediction) dt = maxPrediction;
+    if (dt < -maxPrediction) dt = -maxPrediction;
+
+    integrate(quat, gyro, dt, result);
+
+}
+
+//--------------------------------------------------------------
+OrientationPredictor::OrientationPredictor(){
+    setFilter(1.0f, 1.0f);
+    clear();
+}
+
+//--------------------------------------------------------------
+void OrientationPredictor::setFilter(float minCutoff, float beta){
+    this->minCutoff = minCutoff;
+    this->beta = beta > 0 ? beta : 0;
+}
+
+//--------------------------------------------------------------
+void OrientationPredictor::setMaxPrediction(float seconds){
+    motion.maxPrediction = seconds > 0 ? seconds : 0;
+}
+
+//--------------------------------------------------------------
+void OrientationPredictor::clear(){
+
+    float maxPrediction = motion.maxPrediction;
+    motion = Motion();
+    motion.maxPrediction = maxPrediction;
+
+    hasOffset = false;
+    offset = 0;
+    lastDeviceTime = 0;
+    speed = 0;
+
+}
+
+//--------------------------------------------------------------
+uint64_t OrientationPredictor::getSampleTime(uint64_t deviceTime, uint64_t arrival){
+
+    if (deviceTime == 0) return arrival;
+
+    int64_t delay = (int64_t)(arrival - deviceTime);
+
+    // first sample, Myo Connect restarted, or it's been quiet for a while
+    if (!hasOffset || deviceTime < lastDeviceTime || deviceTime - lastDeviceTime > offsetResetGap) {
+        offset = delay;
+        hasOffset = true;
+    } else {
+        offset += (int64_t)((deviceTime - lastDeviceTime) * offsetCreep);
+        if (delay < offset) offset = delay;
+    }
+
+    lastDeviceTime = deviceTime;
+    return deviceTime + offset;
+
+}
+
+//--------------------------------------------------------------
+void OrientationPredictor::add(uint64_t deviceTime, uint64_t arrival, const float quat[4], const float gyro[3]){
+
+    uint64_t time = getSampleTime(deviceTime, arrival);
+
+    float measured[4] = { quat[0], quat[1], quat[2], quat[3] };
+    normalize(measured);
+
+    float rates[3] = { gyro[0] * degToRad, gyro[1] * degToRad, gyro[2] * degToRad };
+    float magnitude = sqrtf(rates[0] * rates[0] + rates[1] * rates[1] + rates[2] * rates[2]);
+
+    if (!motion.valid || minCutoff <= 0) {
+        for (int i = 0; i < 4; i++) motion.quat[i] = measured[i];
+        speed = magnitude;
+    } else {
+
+        // out of order, or after a gap
+        float dt = (int64_t)(time - motion.time) / 1000000.0f;
+        if (dt <= 0 || dt > 0.25f) dt = 1.0f / imuRate;
+
+        // where the last estimate would be by now, turning at the average
+        // of the last and latest rates
+        float average[3];
+        for (int i = 0; i < 3; i++) average[i] = (motion.gyro[i] + rates[i]) * 0.5f;
+
+        float prior[4];
+        integrate(motion.quat, average, dt, prior);
+
+        // then pulled towards the measurement, harder the faster it's turning
+        speed += getSmoothing(speedCutoff, dt) * (magnitude - speed);
+        float cutoff = minCutoff + beta * speed;
+        slerp(prior, measured, getSmoothing(cutoff, dt), motion.quat);
+    }
+
+    for (int i = 0; i < 3; i++) motion.gyro[i] = rates[i];
+    motion.time = time;
+    motion.valid = true;
+
+}
@@ -0,0 +1,92 @@
+//
+//  ofxMyoWebSocketsPredictor
+//
+//  Smooths the orientation stream and extrapolates it to any point in time
+//  from the gyroscope, e.g. to when the next frame will actually be on
+//  screen. Samples are timed by Myo Connect's own timestamps, mapped onto
+//  the local clock, so network jitter doesn't show up as jerky motion.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+namespace ofxMyoWebSockets {
+
+    // Everything needed to predict an armband's orientation, as of its
+    // latest sample. Plain data, so it's copied along with the armband.
+    struct Motion {
+
+        Motion() : valid(false), time(0), maxPrediction(0.1f) {
+            quat[0] = quat[1] = quat[2] = 0;
+            quat[3] = 1;
+            gyro[0] = gyro[1] = gyro[2] = 0;
+        }
+
+        bool        valid;          // false until the first sample
+
+        // Smoothed orientation (x, y, z, w) and angular velocity in rad/s,
+        // in the armband's frame, at time
+        float       quat[4];
+        float       gyro[3];
+
+        // When the latest sample was taken, in local clock microseconds
+        uint64_t    time;
+
+        // Predictions are never extrapolated further than this from time,
+        // in seconds
+        float       maxPrediction;
+
+        // Orientation at time, in local clock microseconds, into result
+        // (x, y, z, w)
+        void        predict(uint64_t time, float result[4]) const;
+
+    };
+
+    class OrientationPredictor {
+
+    public:
+
+        OrientationPredictor();
+
+        // One Euro filter: the cutoff frequency (in Hz) rises from
+        // minCutoff by beta per rad/s of angular speed, so slow movement is
+        // smoothed a lot and fast movement hardly lags. Between samples the
+        // filtered orientation follows the gyroscope, so smoothing doesn't
+        // lag steady rotation either. A minCutoff of 0 turns smoothing off.
+        // 1Hz and 1 by default.
+        void        setFilter(float minCutoff, float beta);
+        void        setMaxPrediction(float seconds);
+
+        void        clear();
+
+        // deviceTime is Myo Connect's timestamp of the sample (0 if there's
+        // none), arrival when it got here, both in microseconds. gyro in
+        // deg/s as sent.
+        void        add(uint64_t deviceTime, uint64_t arrival, const float quat[4], const float gyro[3]);
+
+        const Motion&   getMotion() const { return motion; }
+
+        // Nominal IMU rate, for when the timestamps are no help
+        static const int    imuRate = 50;
+
+    private:
+
+        // Local time of a sample, from the smallest delay seen between Myo
+        // Connect's clock and ours, which is allowed to creep up slowly in
+        // case the delay grows for good
+        uint64_t    getSampleTime(uint64_t deviceTime, uint64_t arrival);
+
+        float       minCutoff;
+        float       beta;
+
+        Motion      motion;
+
+        bool        hasOffset;
+        int64_t     offset;             // local - device
+        uint64_t    lastDeviceTime;
+        float       speed;              // filtered angular speed, rad/s
+
+    };
+
+}
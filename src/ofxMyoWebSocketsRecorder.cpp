@@ -0,0 +1,255 @@
+//
+//  ofxMyoWebSocketsRecorder
+//
+
+#include "ofxMyoWebSocketsRecorder.h"
+#include "ofxMyoWebSockets.h"
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    const char      magic[6] = { 'M', 'Y', 'O', 'L', 'O', 'G' };
+    const uint16_t  version = 1;
+    const size_t    headerSize = 8;
+
+    size_t writeVarint(uint64_t value, unsigned char* out) {
+        size_t length = 0;
+        while (value >= 0x80) {
+            out[length++] = (unsigned char)(value | 0x80);
+            value >>= 7;
+        }
+        out[length++] = (unsigned char)value;
+        return length;
+    }
+
+    bool readVarint(const char* data, size_t size, size_t& position, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position >= size) return false;
+            unsigned char byte = data[position++];
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+}
+
+//--------------------------------------------------------------
+Recorder::Recorder(){
+    file = NULL;
+    lastTimestamp = 0;
+    messageCount = 0;
+}
+
+//--------------------------------------------------------------
+Recorder::~Recorder(){
+    stop();
+}
+
+//--------------------------------------------------------------
+bool Recorder::start(string path){
+
+    stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    file = fopen(ofToDataPath(path).c_str(), "wb");
+    if (!file) {
+        ofLogError("ofxMyoWebSockets") << "Couldn't open " << path << " for recording";
+        return false;
+    }
+
+    // big buffer so the socket thread rarely has to wait on the disk
+    buffer.resize(1 << 16);
+    setvbuf(file, &buffer[0], _IOFBF, buffer.size());
+
+    unsigned char header[headerSize];
+    memcpy(header, magic, sizeof(magic));
+    header[6] = version & 0xFF;
+    header[7] = version >> 8;
+    fwrite(header, 1, headerSize, file);
+
+    lastTimestamp = 0;
+    messageCount = 0;
+
+    return true;
+
+}
+
+//--------------------------------------------------------------
+void Recorder::stop(){
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (file) {
+        fclose(file);
+        file = NULL;
+    }
+
+}
+
+//--------------------------------------------------------------
+bool Recorder::isRecording(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return file != NULL;
+}
+
+//--------------------------------------------------------------
+void Recorder::record(const char* message, size_t length, uint64_t timestamp){
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file) return;
+
+    // the first message starts the clock
+    if (messageCount == 0) lastTimestamp = timestamp;
+    uint64_t delta = timestamp > lastTimestamp ? timestamp - lastTimestamp : 0;
+    lastTimestamp = timestamp;
+
+    unsigned char prefix[20];
+    size_t prefixLength = writeVarint(delta, prefix);
+    prefixLength += writeVarint(length, prefix + prefixLength);
+
+    fwrite(prefix, 1, prefixLength, file);
+    fwrite(message, 1, length, file);
+
+    messageCount++;
+
+}
+
+//--------------------------------------------------------------
+Player::Player(){
+    connection = NULL;
+    speed = 1.0f;
+    loop = false;
+}
+
+//--------------------------------------------------------------
+Player::~Player(){
+    stop();
+}
+
+//--------------------------------------------------------------
+bool Player::load(string path){
+
+    stop();
+
+    data.clear();
+    offsets.clear();
+    lengths.clear();
+    timestamps.clear();
+
+    ofBuffer buffer = ofBufferFromFile(path, true);
+
+    if (buffer.size() < headerSize || memcmp(buffer.getData(), magic, sizeof(magic)) != 0) {
+        ofLogError("ofxMyoWebSockets") << path << " isn't a Myo recording";
+        return false;
+    }
+
+    const unsigned char* header = (const unsigned char*)buffer.getData();
+    uint16_t fileVersion = header[6] | (header[7] << 8);
+    if (fileVersion != version) {
+        ofLogError("ofxMyoWebSockets") << path << " is a version " << fileVersion << " recording, expected " << version;
+        return false;
+    }
+
+    data.assign(buffer.getData(), buffer.getData() + buffer.size());
+
+    size_t position = headerSize;
+    uint64_t time = 0;
+
+    while (position < data.size()) {
+
+        uint64_t delta, length;
+        if (!readVarint(&data[0], data.size(), position, delta) ||
+            !readVarint(&data[0], data.size(), position, length) ||
+            length > data.size() - position) {
+            ofLogWarning("ofxMyoWebSockets") << path << " is truncated, playing the first " << offsets.size() << " messages";
+            break;
+        }
+
+        time += delta;
+
+        offsets.push_back(position);
+        lengths.push_back(length);
+        timestamps.push_back(time);
+
+        position += length;
+    }
+
+    return true;
+
+}
+
+//--------------------------------------------------------------
+float Player::getDuration(){
+    return timestamps.empty() ? 0 : timestamps.back() / 1000000.0f;
+}
+
+//--------------------------------------------------------------
+void Player::play(Connection& connection, float speed, bool loop){
+
+    stop();
+
+    this->connection = &connection;
+    this->speed = speed;
+    this->loop = loop;
+
+    startThread();
+
+}
+
+//--------------------------------------------------------------
+void Player::stop(){
+    waitForThread(true);
+}
+
+//--------------------------------------------------------------
+int Player::playAll(Connection& connection){
+
+    for (int i = 0; i < offsets.size(); i++) {
+        playMessage(connection, i);
+    }
+
+    return offsets.size();
+
+}
+
+//--------------------------------------------------------------
+void Player::playMessage(Connection& connection, int index){
+    message.assign(data.data() + offsets[index], lengths[index]);
+    connection.processMessage(message);
+}
+
+//--------------------------------------------------------------
+void Player::threadedFunction(){
+
+    do {
+
+        // the connection's clock, so a simulated one plays back in step
+        uint64_t start = connection->getElapsedTimeMicros();
+
+        for (int i = 0; i < offsets.size() && isThreadRunning(); i++) {
+
+            // wait until it's time for this message
+            while (speed > 0 && isThreadRunning()) {
+
+                uint64_t due = start + (uint64_t)(timestamps[i] / speed);
+                uint64_t now = connection->getElapsedTimeMicros();
+                if (now >= due) break;
+
+                // sleep most of the way, then yield for the last bit
+                uint64_t remaining = due - now;
+                if (remaining > 2000) sleep((remaining - 1000) / 1000);
+                else yield();
+            }
+
+            // stop() may have come in while waiting
+            if (!isThreadRunning()) break;
+            playMessage(*connection, i);
+        }
+
+    } while (loop && isThreadRunning());
+
+}
@@ -0,0 +1,100 @@
+//
+//  ofxMyoWebSocketsRecorder
+//
+//  Record the raw messages coming from Myo Connect into a compact binary
+//  log, and play them back through a Connection later, e.g. to develop or
+//  benchmark without any armbands around.
+//
+//  Log format: an 8 byte header ("MYOLOG" + version 1 as a uint16), then one
+//  record per message: varint microseconds since the previous message,
+//  varint message length, and the message bytes.
+//
+
+#pragma once
+
+#include "ofMain.h"
+#include "ofxMyoWebSocketsPolicies.h"
+
+namespace ofxMyoWebSockets {
+
+    // Connection includes this, and needs Recorder complete before its
+    // definitions, so just declare it here
+    template<class Policies> class BasicConnection;
+    typedef BasicConnection<DefaultPolicies> Connection;
+
+    class Recorder {
+
+    public:
+
+        Recorder();
+        ~Recorder();
+
+        // path goes through ofToDataPath()
+        bool            start(string path);
+        void            stop();
+        bool            isRecording();
+
+        // Called by Connection on the socket thread. timestamp is in
+        // microseconds from any monotonic clock.
+        void            record(const char* message, size_t length, uint64_t timestamp);
+
+        unsigned int    getMessageCount() { return messageCount; }
+
+    private:
+
+        std::mutex      mutex;
+        FILE*           file;
+        vector<char>    buffer;
+
+        uint64_t        lastTimestamp;
+        unsigned int    messageCount;
+
+    };
+
+
+    class Player : public ofThread {
+
+    public:
+
+        Player();
+        ~Player();
+
+        bool            load(string path);
+        int             getNumMessages() { return offsets.size(); }
+
+        // Length of the recording in seconds
+        float           getDuration();
+
+        // Feed the recording through connection.processMessage() on a
+        // background thread. speed: 1 is real time, 2 twice as fast and so
+        // on, or 0 to go as fast as possible. Paced by the connection's
+        // clock (see Connection::setClock()).
+        void            play(Connection& connection, float speed = 1.0f, bool loop = false);
+        void            stop();
+        bool            isPlaying() { return isThreadRunning(); }
+
+        // Feed the whole recording through connection.processMessage() on
+        // the calling thread as fast as possible. Returns the number of
+        // messages played.
+        int             playAll(Connection& connection);
+
+        void            threadedFunction();
+
+    private:
+
+        void            playMessage(Connection& connection, int index);
+
+        vector<char>        data;
+        vector<size_t>      offsets;    // start of each message in data
+        vector<size_t>      lengths;
+        vector<uint64_t>    timestamps; // microseconds since the first message
+
+        string          message;        // reused to avoid allocating per message
+
+        Connection*     connection;
+        float           speed;
+        bool            loop;
+
+    };
+
+}
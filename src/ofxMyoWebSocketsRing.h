@@ -0,0 +1,113 @@
+//
+//  ofxMyoWebSocketsRing
+//
+//  Sequence number arithmetic shared by the ring buffers: ImuHistory,
+//  EmgHistory and the shared memory histories. The writer numbers its
+//  samples 0, 1, 2, ... (wrapping at 2^32), sample n goes in slot n & mask,
+//  and a window is the samples from first up to, not including, end().
+//
+//  Only needs the standard library, like ofxMyoWebSocketsSharedMemory.
+//
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+namespace ofxMyoWebSockets {
+
+    struct RingWindow {
+
+        unsigned int    mask;       // capacity - 1, a power of two
+        unsigned int    first;      // sequence number of the oldest sample
+        int             count;
+
+        RingWindow() : mask(0), first(0), count(0) {}
+        RingWindow(unsigned int mask, unsigned int first, unsigned int end) : mask(mask), first(first), count(end - first) {}
+
+        int             size() const { return count; }
+        bool            empty() const { return count == 0; }
+
+        // Sequence number just past the newest sample, i.e. where to carry
+        // on from next time with getFrom()
+        unsigned int    end() const { return first + count; }
+
+        // Slot of the i-th sample in the window
+        int             index(int i) const { return (first + i) & mask; }
+
+        // Only the newest 3/4 of a buffer is handed out to readers, the
+        // rest is headroom so windows stay valid for a while
+        static int      getReadableCapacity(unsigned int mask) { return (mask + 1) - (mask + 1) / 4; }
+
+        // Everything from oldest (e.g. since a clear()) up to end, the
+        // writer's next sequence number, that's readable
+        static RingWindow getReadable(unsigned int mask, unsigned int oldest, unsigned int end){
+            unsigned int readable = getReadableCapacity(mask);
+            if (end - oldest > readable) oldest = end - readable;
+            return RingWindow(mask, oldest, end);
+        }
+
+        // The newest count samples of this window
+        RingWindow      getLast(int count) const {
+            if (count < 0) count = 0;
+            if (this->count <= count) return *this;
+            return RingWindow(mask, end() - count, end());
+        }
+
+        // Everything from sequence on. If that's already dropped out of
+        // the window, all of it; if it's beyond the newest sample, nothing.
+        // Sequence numbers wrap, so this compares distances, and anything
+        // more than 2^31 samples away counts as ahead.
+        RingWindow      getFrom(unsigned int sequence) const {
+            if ((int)(sequence - end()) >= 0) return RingWindow(mask, end(), end());
+            if (end() - sequence >= (unsigned int)count) return *this;
+            return RingWindow(mask, sequence, end());
+        }
+
+        // Samples strictly newer than timestamp, by binary search since
+        // they're in order. timestampAt(slot) reads the timestamp in a slot.
+        template<class TimestampAt>
+        RingWindow      getSince(uint64_t timestamp, const TimestampAt& timestampAt) const {
+            int low = 0;
+            int high = count;
+            while (low < high) {
+                int middle = (low + high) / 2;
+                if (timestampAt(index(middle)) > timestamp) high = middle;
+                else low = middle + 1;
+            }
+            return RingWindow(mask, first + low, end());
+        }
+
+        // The window as up to two contiguous runs of slots (it may wrap
+        // around the end). Returns the number of runs.
+        int             getRuns(int offsets[2], int lengths[2]) const {
+            if (count == 0) return 0;
+
+            int start = index(0);
+            int capacity = mask + 1;
+
+            offsets[0] = start;
+            lengths[0] = count;
+            if (start + count <= capacity) return 1;
+
+            lengths[0] = capacity - start;
+            offsets[1] = 0;
+            lengths[1] = count - lengths[0];
+            return 2;
+        }
+
+        // False once the oldest sample has been (or is being) overwritten,
+        // given the writer's count of samples written. Call once you've
+        // read the samples.
+        bool            isValid(const std::atomic<uint32_t>& written) const {
+            // reads of the samples themselves happen before this
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // the writer fills in sample written - capacity before moving
+            // written on, so that one may already be half overwritten
+            return written.load(std::memory_order_relaxed) - first < mask + 1;
+        }
+
+    };
+
+}
@@ -0,0 +1,157 @@
+//
+//  ofxMyoWebSocketsScheduler
+//
+
+#include "ofxMyoWebSocketsScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    // how long the thread waits before trying a callback again
+    const int retryMicros = 1000;
+
+}
+
+//--------------------------------------------------------------
+uint64_t Scheduler::getSteadyMicros(){
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+//--------------------------------------------------------------
+Scheduler::Scheduler(){
+    running = false;
+    entries.reserve(64);
+}
+
+//--------------------------------------------------------------
+Scheduler::~Scheduler(){
+    stop();
+}
+
+//--------------------------------------------------------------
+void Scheduler::start(Callback callback, Clock clock){
+
+    stop();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->callback = callback;
+        this->clock = clock;
+        running = true;
+    }
+
+    thread = std::thread(&Scheduler::threadedFunction, this);
+
+}
+
+//--------------------------------------------------------------
+void Scheduler::stop(){
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    condition.notify_one();
+
+    if (thread.joinable()) thread.join();
+
+}
+
+//--------------------------------------------------------------
+void Scheduler::schedule(int key, int kind, uint64_t deadline){
+
+    Entry entry;
+    entry.deadline = deadline;
+    entry.key = key;
+    entry.kind = kind;
+
+    bool earliest;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        push(entry);
+        earliest = entries.front().deadline == deadline;
+    }
+
+    // only wake the thread if it's sleeping for longer than it should
+    if (earliest) condition.notify_one();
+
+}
+
+//--------------------------------------------------------------
+void Scheduler::poll(){
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // nothing to call back until start()
+    while (running && !entries.empty() && entries.front().deadline <= clock()) {
+
+        Entry next = entries.front();
+        std::pop_heap(entries.begin(), entries.end(), std::greater<Entry>());
+        entries.pop_back();
+
+        lock.unlock();
+        bool done = callback(next.key, next.kind, next.deadline);
+        lock.lock();
+
+        if (!done) {
+            push(next);
+            return;
+        }
+    }
+
+}
+
+//--------------------------------------------------------------
+void Scheduler::push(const Entry& entry){
+    entries.push_back(entry);
+    std::push_heap(entries.begin(), entries.end(), std::greater<Entry>());
+}
+
+//--------------------------------------------------------------
+int Scheduler::getPendingCount(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+//--------------------------------------------------------------
+void Scheduler::threadedFunction(){
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (running) {
+
+        if (entries.empty()) {
+            condition.wait(lock);
+            continue;
+        }
+
+        uint64_t now = clock();
+        Entry next = entries.front();
+
+        if (next.deadline > now) {
+            condition.wait_for(lock, std::chrono::microseconds(next.deadline - now));
+            continue;
+        }
+
+        std::pop_heap(entries.begin(), entries.end(), std::greater<Entry>());
+        entries.pop_back();
+
+        // the callback is free to schedule more
+        lock.unlock();
+        bool done = callback(next.key, next.kind, next.deadline);
+        lock.lock();
+
+        // or to be left to poll(), in which case look again in a bit
+        if (!done) {
+            push(next);
+            condition.wait_for(lock, std::chrono::microseconds(retryMicros));
+        }
+    }
+
+}
@@ -0,0 +1,90 @@
+//
+//  ofxMyoWebSocketsScheduler
+//
+//  Calls back at deadlines from its own thread, independent of the app's
+//  frame rate. Deadlines live in a min-heap, so the thread sleeps until the
+//  earliest one and only ever looks at what's due.
+//
+//  There's no cancelling: an entry that's been overtaken (e.g. a pose which
+//  was replaced before it was confirmed) still fires, and it's up to the
+//  callback to check it against the current deadline and ignore it.
+//
+//  A callback that can't get at what it needs right now returns false, and
+//  is called back again from the next poll(), or by the thread shortly.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+namespace ofxMyoWebSockets {
+
+    class Scheduler {
+
+    public:
+
+        // key and kind are whatever was passed to schedule(). Returns false
+        // to be tried again.
+        typedef std::function<bool(int key, int kind, uint64_t deadline)> Callback;
+
+        // Microseconds, from the same clock the deadlines come from
+        typedef std::function<uint64_t()> Clock;
+
+        // Microseconds on std::chrono::steady_clock since it was first
+        // called in this process, so every connection agrees. Connection's
+        // clock unless it's given another.
+        static uint64_t getSteadyMicros();
+
+        Scheduler();
+        ~Scheduler();
+
+        void            start(Callback callback, Clock clock);
+        void            stop();
+        bool            isRunning() { return thread.joinable(); }
+
+        // Any thread. Callbacks for deadlines which have already passed
+        // happen right away.
+        void            schedule(int key, int kind, uint64_t deadline);
+
+        // Calls back for everything that's due by now on the calling
+        // thread. The thread sleeps in real time, so with a clock that
+        // isn't (e.g. simulated time) this is what keeps deadlines on time.
+        // Stops at the first callback that returns false.
+        void            poll();
+
+        int             getPendingCount();
+
+    private:
+
+        struct Entry {
+            uint64_t    deadline;
+            int         key;
+            int         kind;
+
+            bool operator>(const Entry& other) const { return deadline > other.deadline; }
+        };
+
+        void            threadedFunction();
+
+        // puts an entry back, with the lock held
+        void            push(const Entry& entry);
+
+        std::mutex              mutex;
+        std::condition_variable condition;
+        std::thread             thread;
+        bool                    running;
+
+        Callback                callback;
+        Clock                   clock;
+
+        // min-heap on deadline, guarded by mutex
+        std::vector<Entry>      entries;
+
+    };
+
+}
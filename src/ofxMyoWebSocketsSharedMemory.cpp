@@ -0,0 +1,370 @@
+//
+//  ofxMyoWebSocketsSharedMemory
+//
+
+#include "ofxMyoWebSocketsSharedMemory.h"
+
+#include <string.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    const uint32_t magic = 0x534f594d;  // "MYOS"
+    const uint32_t version = 1;
+
+    // Armband blocks start on their own cache lines, so readers of one
+    // don't slow down writes to the next
+    const size_t cacheLine = 64;
+
+    // A write takes well under a microsecond, so if the state still isn't
+    // settled after this many tries the publisher died halfway through
+    const int readAttempts = 100000;
+
+    //--------------------------------------------------------------
+    size_t getArmbandSize(int historySize){
+        size_t size = sizeof(SharedArmband) + historySize * sizeof(SharedSample);
+        return (size + cacheLine - 1) / cacheLine * cacheLine;
+    }
+
+    //--------------------------------------------------------------
+    size_t getHeaderSize(){
+        return (sizeof(SharedHeader) + cacheLine - 1) / cacheLine * cacheLine;
+    }
+
+}
+
+//--------------------------------------------------------------
+bool SharedSamples::isValid() const{
+    return armband && RingWindow::isValid(armband->written);
+}
+
+//--------------------------------------------------------------
+SharedMemoryPublisher::SharedMemoryPublisher(){
+    header = NULL;
+    size = 0;
+}
+
+//--------------------------------------------------------------
+SharedMemoryPublisher::~SharedMemoryPublisher(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool SharedMemoryPublisher::open(const std::string& name, int maxArmbands, int historySize){
+
+    close();
+
+#ifdef _WIN32
+    error = "Shared memory needs POSIX";
+    return false;
+#else
+
+    int capacity = 1;
+    while (capacity < historySize) capacity <<= 1;
+    if (maxArmbands < 1) maxArmbands = 1;
+
+    size_t armbandSize = getArmbandSize(capacity);
+    size_t size = getHeaderSize() + maxArmbands * armbandSize;
+
+    // always a fresh segment, readers of an old one keep it until they
+    // let go
+    shm_unlink(name.c_str());
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        error = "Couldn't create " + name + ": " + strerror(errno);
+        return false;
+    }
+
+    if (ftruncate(fd, size) != 0) {
+        error = "Couldn't size " + name + ": " + strerror(errno);
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (memory == MAP_FAILED) {
+        error = "Couldn't map " + name + ": " + strerror(errno);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // a new segment is all zeros, so the armbands are empty already
+    header = static_cast<SharedHeader*>(memory);
+    header->version = version;
+    header->maxArmbands = maxArmbands;
+    header->historySize = capacity;
+    header->armbandSize = armbandSize;
+    header->publishCount.store(0, std::memory_order_relaxed);
+    header->open.store(1, std::memory_order_relaxed);
+
+    // readers check this last
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = magic;
+
+    this->name = name;
+    this->size = size;
+    error.clear();
+    return true;
+
+#endif
+
+}
+
+//--------------------------------------------------------------
+void SharedMemoryPublisher::close(){
+
+#ifndef _WIN32
+    if (!header) return;
+
+    header->open.store(0, std::memory_order_release);
+    munmap(header, size);
+    shm_unlink(name.c_str());
+#endif
+
+    header = NULL;
+    size = 0;
+
+}
+
+//--------------------------------------------------------------
+SharedArmband* SharedMemoryPublisher::getArmband(int slot){
+
+    if (!header || slot < 0 || slot >= (int)header->maxArmbands) return NULL;
+
+    char* base = reinterpret_cast<char*>(header) + getHeaderSize();
+    return reinterpret_cast<SharedArmband*>(base + slot * header->armbandSize);
+
+}
+
+//--------------------------------------------------------------
+void SharedMemoryPublisher::setArmband(int slot, SharedArmbandState state){
+
+    SharedArmband* armband = getArmband(slot);
+    if (!armband) return;
+
+    // removeArmband() moved this on past the previous armband's samples
+    state.active = 1;
+    state.firstSample = armband->state.firstSample;
+
+    uint32_t sequence = armband->sequence.load(std::memory_order_relaxed);
+    armband->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    armband->state = state;
+
+    armband->sequence.store(sequence + 2, std::memory_order_release);
+    header->publishCount.fetch_add(1, std::memory_order_release);
+
+}
+
+//--------------------------------------------------------------
+void SharedMemoryPublisher::removeArmband(int slot){
+
+    SharedArmband* armband = getArmband(slot);
+    if (!armband) return;
+
+    uint32_t sequence = armband->sequence.load(std::memory_order_relaxed);
+    armband->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memset(&armband->state, 0, sizeof(armband->state));
+    armband->state.firstSample = armband->written.load(std::memory_order_relaxed);
+
+    armband->sequence.store(sequence + 2, std::memory_order_release);
+    header->publishCount.fetch_add(1, std::memory_order_release);
+
+}
+
+//--------------------------------------------------------------
+void SharedMemoryPublisher::addSample(int slot, uint64_t timestamp, const float accel[3], const float gyro[3], const float quat[4]){
+
+    SharedArmband* armband = getArmband(slot);
+    if (!armband) return;
+
+    uint32_t sequence = armband->written.load(std::memory_order_relaxed);
+    SharedSample& sample = armband->getSamples()[sequence & (header->historySize - 1)];
+
+    sample.timestamp = timestamp;
+    memcpy(sample.accel, accel, sizeof(sample.accel));
+    memcpy(sample.gyro, gyro, sizeof(sample.gyro));
+    memcpy(sample.quat, quat, sizeof(sample.quat));
+
+    armband->written.store(sequence + 1, std::memory_order_release);
+
+}
+
+//--------------------------------------------------------------
+SharedMemoryReader::SharedMemoryReader(){
+    header = NULL;
+    size = 0;
+}
+
+//--------------------------------------------------------------
+SharedMemoryReader::~SharedMemoryReader(){
+    close();
+}
+
+//--------------------------------------------------------------
+bool SharedMemoryReader::open(const std::string& name){
+
+    close();
+
+#ifdef _WIN32
+    error = "Shared memory needs POSIX";
+    return false;
+#else
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        error = "Couldn't open " + name + ": " + strerror(errno);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < getHeaderSize()) {
+        error = name + " isn't ready yet";
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = info.st_size;
+    void* memory = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (memory == MAP_FAILED) {
+        error = "Couldn't map " + name + ": " + strerror(errno);
+        return false;
+    }
+
+    const SharedHeader* header = static_cast<const SharedHeader*>(memory);
+    uint32_t found = header->magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (found != magic) {
+        error = name + " isn't ready yet, or isn't from a SharedMemoryPublisher";
+    } else if (header->version != version) {
+        error = name + " is version " + std::to_string(header->version) + ", expected " + std::to_string(version);
+    } else if (size < getHeaderSize() + header->maxArmbands * (size_t)header->armbandSize) {
+        error = name + " is truncated";
+    } else {
+        this->header = header;
+        this->size = size;
+        error.clear();
+        return true;
+    }
+
+    munmap(memory, size);
+    return false;
+
+#endif
+
+}
+
+//--------------------------------------------------------------
+void SharedMemoryReader::close(){
+
+#ifndef _WIN32
+    if (header) munmap(const_cast<SharedHeader*>(header), size);
+#endif
+
+    header = NULL;
+    size = 0;
+
+}
+
+//--------------------------------------------------------------
+bool SharedMemoryReader::isPublishing() const{
+    return header && header->open.load(std::memory_order_acquire);
+}
+
+//--------------------------------------------------------------
+unsigned int SharedMemoryReader::getPublishCount() const{
+    return header ? header->publishCount.load(std::memory_order_acquire) : 0;
+}
+
+//--------------------------------------------------------------
+const SharedArmband* SharedMemoryReader::getArmband(int slot) const{
+
+    if (!header || slot < 0 || slot >= (int)header->maxArmbands) return NULL;
+
+    const char* base = reinterpret_cast<const char*>(header) + getHeaderSize();
+    return reinterpret_cast<const SharedArmband*>(base + slot * header->armbandSize);
+
+}
+
+//--------------------------------------------------------------
+bool SharedMemoryReader::read(int slot, SharedArmbandState& state) const{
+
+    const SharedArmband* armband = getArmband(slot);
+    if (!armband) return false;
+
+    // try again until the copy wasn't written to halfway through, but not
+    // forever in case the publisher is gone
+    for (int attempt = 0; attempt < readAttempts; attempt++) {
+        uint32_t before = armband->sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+
+        memcpy(&state, &armband->state, sizeof(state));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (armband->sequence.load(std::memory_order_relaxed) == before) return state.active != 0;
+    }
+
+    memset(&state, 0, sizeof(state));
+    return false;
+
+}
+
+//--------------------------------------------------------------
+int SharedMemoryReader::find(int myoID, int host) const{
+
+    SharedArmbandState state;
+    for (int i = 0; i < getMaxArmbands(); i++) {
+        if (read(i, state) && state.id == myoID && state.host == host) return i;
+    }
+
+    return -1;
+
+}
+
+//--------------------------------------------------------------
+SharedSamples SharedMemoryReader::getAll(int slot) const{
+
+    const SharedArmband* armband = getArmband(slot);
+    if (!armband) return SharedSamples();
+
+    SharedArmbandState state;
+    read(slot, state);
+
+    unsigned int end = armband->written.load(std::memory_order_acquire);
+
+    // leaves out samples from before the armband took the slot, and ones
+    // about to be overwritten
+    return SharedSamples(armband, RingWindow::getReadable(header->historySize - 1, state.firstSample, end));
+
+}
+
+//--------------------------------------------------------------
+SharedSamples SharedMemoryReader::getLast(int slot, int count) const{
+    SharedSamples samples = getAll(slot);
+    return SharedSamples(samples.armband, samples.getLast(count));
+}
+
+//--------------------------------------------------------------
+SharedSamples SharedMemoryReader::getFrom(int slot, unsigned int first) const{
+    SharedSamples samples = getAll(slot);
+    return SharedSamples(samples.armband, samples.getFrom(first));
+}
@@ -0,0 +1,213 @@
+//
+//  ofxMyoWebSocketsSharedMemory
+//
+//  Hands every armband's latest state and orientation history from one
+//  Connection to any number of other local processes through a POSIX
+//  shared memory segment, so they don't each need a socket to Myo Connect
+//  or to parse the same JSON again. There's one writer (Connection's
+//  socket thread) and readers never block it: each armband's state sits
+//  behind a sequence lock, and its history is a ring buffer read in place,
+//  like ImuHistory.
+//
+//  This file and its .cpp only need the standard library and POSIX, so
+//  readers can use them without openFrameworks. Not available on Windows.
+//
+//  Layout, all little endian as written: a SharedHeader, then maxArmbands
+//  blocks of header.armbandSize bytes, each a SharedArmband followed by
+//  header.historySize SharedSamples.
+//
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ofxMyoWebSocketsRing.h"
+
+namespace ofxMyoWebSockets {
+
+    struct SharedHeader {
+
+        uint32_t                magic;          // "MYOS"
+        uint32_t                version;
+        uint32_t                maxArmbands;
+        uint32_t                historySize;    // a power of two
+        uint32_t                armbandSize;    // bytes per armband block
+        uint32_t                reserved;
+
+        // Bumped every time any armband's state is published, cheap to poll
+        std::atomic<uint32_t>   publishCount;
+
+        // 1 until the publisher closes the segment. Readers should reopen
+        // by name after that, a new publisher creates a new segment.
+        std::atomic<uint32_t>   open;
+
+    };
+
+    // Plain copy of an armband's state, see Armband. Enums as ints.
+    struct SharedArmbandState {
+
+        int32_t     active;         // 0 if the slot is empty
+        int32_t     id;
+        int32_t     host;
+        int32_t     rssi;
+
+        int32_t     arm;            // Arm
+        int32_t     direction;      // XDirection
+        int32_t     pose;           // Pose
+        int32_t     lastPose;
+
+        int32_t     stale;
+        int32_t     unlocked;
+        int32_t     poseConfirmed;
+
+        // Sequence number of this armband's first history sample, samples
+        // before it belong to whoever had the slot before
+        uint32_t    firstSample;
+
+        uint64_t    timestamp;      // Myo Connect's, microseconds
+
+        float       accel[3];       // g
+        float       gyro[3];        // deg/s
+        float       quat[4];        // x, y, z, w
+
+    };
+
+    struct SharedSample {
+        uint64_t    timestamp;      // by the connection's clock, on arrival
+        float       accel[3];
+        float       gyro[3];
+        float       quat[4];
+    };
+
+    struct SharedArmband {
+
+        // Odd while state is being written
+        std::atomic<uint32_t>   sequence;
+        uint32_t                reserved;
+
+        SharedArmbandState      state;
+
+        // Number of history samples ever written, the sequence number the
+        // next one will get
+        std::atomic<uint32_t>   written;
+        uint32_t                reserved2;
+
+        // followed by the history
+        const SharedSample*     getSamples() const { return reinterpret_cast<const SharedSample*>(this + 1); }
+        SharedSample*           getSamples() { return reinterpret_cast<SharedSample*>(this + 1); }
+
+    };
+
+    // A window of an armband's history, oldest first, read in place like
+    // ImuSamples. Check isValid() once you're done with it, in case the
+    // publisher has overwritten some of it in the meantime. first, count,
+    // end() etc. come from RingWindow.
+    struct SharedSamples : RingWindow {
+
+        const SharedArmband*    armband;
+
+        SharedSamples() : armband(NULL) {}
+        SharedSamples(const SharedArmband* armband, const RingWindow& window) : RingWindow(window), armband(armband) {}
+
+        const SharedSample& sample(int i) const { return armband->getSamples()[index(i)]; }
+        uint64_t        timestamp(int i) const { return sample(i).timestamp; }
+
+        // False once the oldest sample has been (or is being) overwritten
+        bool            isValid() const;
+
+    };
+
+    class SharedMemoryPublisher {
+
+    public:
+
+        SharedMemoryPublisher();
+        ~SharedMemoryPublisher();
+
+        // name as for shm_open(), e.g. "/myo". Replaces any segment of the
+        // same name, readers of that one see it close. Use the same number
+        // of armbands as the connection (16 by default). historySize is
+        // rounded up to a power of two.
+        bool            open(const std::string& name = "/ofxMyoWebSockets", int maxArmbands = 16, int historySize = 256);
+        void            close();
+        bool            isOpen() const { return header != NULL; }
+
+        // Why open() failed
+        const std::string&  getError() const { return error; }
+
+        // Writer side, called by Connection on the socket thread. slot is
+        // the armband's slot in the connection. state.firstSample is
+        // filled in here.
+        void            setArmband(int slot, SharedArmbandState state);
+        void            removeArmband(int slot);
+        void            addSample(int slot, uint64_t timestamp, const float accel[3], const float gyro[3], const float quat[4]);
+
+    private:
+
+        SharedArmband*  getArmband(int slot);
+
+        std::string     name;
+        std::string     error;
+
+        SharedHeader*   header;
+        size_t          size;
+
+    };
+
+    class SharedMemoryReader {
+
+    public:
+
+        SharedMemoryReader();
+        ~SharedMemoryReader();
+
+        bool            open(const std::string& name = "/ofxMyoWebSockets");
+        void            close();
+        bool            isOpen() const { return header != NULL; }
+
+        // False once the publisher has gone, reopen to pick up a new one
+        bool            isPublishing() const;
+
+        const std::string&  getError() const { return error; }
+
+        int             getMaxArmbands() const { return header ? header->maxArmbands : 0; }
+        int             getHistorySize() const { return header ? header->historySize : 0; }
+
+        // Only the newest 3/4 of each history is handed out, the rest is
+        // headroom for the publisher
+        int             getReadableHistorySize() const { return header ? RingWindow::getReadableCapacity(header->historySize - 1) : 0; }
+
+        // Compare with a previous value to see if anything's changed
+        unsigned int    getPublishCount() const;
+
+        // A consistent copy of the armband's latest state. Returns false if
+        // there's no armband in the slot, or the publisher died halfway
+        // through writing it.
+        bool            read(int slot, SharedArmbandState& state) const;
+
+        // Slot of an armband, -1 if it isn't there
+        int             find(int myoID, int host = 0) const;
+
+        // The armband's history, read in place
+        SharedSamples   getAll(int slot) const;
+        SharedSamples   getLast(int slot, int count) const;
+
+        // Everything from sequence number first on, e.g. the previous
+        // window's end(). Nothing if first hasn't been written yet.
+        SharedSamples   getFrom(int slot, unsigned int first) const;
+
+    private:
+
+        const SharedArmband*    getArmband(int slot) const;
+
+        std::string             error;
+
+        const SharedHeader*     header;
+        size_t                  size;
+
+    };
+
+}
@@ -0,0 +1,191 @@
+//
+//  ofxMyoWebSocketsSlotPool
+//
+//  Fixed-capacity pool of objects keyed by an int id (e.g. a Myo id). All
+//  storage is allocated up front, so pointers into the pool stay valid for
+//  its lifetime, lookups are O(1) through a small open-addressing table,
+//  and released slots are reused. Handles carry a generation so a handle to
+//  a released slot can be told apart from whatever reuses it later.
+//
+//  Not thread safe.
+//
+
+#pragma once
+
+#include <vector>
+#include <stddef.h>
+
+namespace ofxMyoWebSockets {
+
+    struct SlotHandle {
+
+        int             slot;
+        unsigned int    generation;
+
+        SlotHandle() : slot(-1), generation(0) {}
+        bool isValid() const { return slot >= 0; }
+
+    };
+
+    template<typename T>
+    class SlotPool {
+
+    public:
+
+        SlotPool(int capacity = 64) { setCapacity(capacity); }
+
+        // Releases everything
+        void setCapacity(int capacity) {
+
+            slots.assign(capacity, Slot());
+            active.clear();
+            active.reserve(capacity);
+            freeSlots.clear();
+            freeSlots.reserve(capacity);
+
+            for (int i = capacity - 1; i >= 0; i--) {
+                freeSlots.push_back(i);
+            }
+
+            // keep the table at most half full
+            int size = 1;
+            while (size < capacity * 2) size <<= 1;
+            table.assign(size, -1);
+            mask = size - 1;
+
+        }
+
+        int capacity() const { return slots.size(); }
+
+        // Number of slots in use, and access to them in the order they were
+        // acquired
+        int size() const { return active.size(); }
+        T*  operator[](int i) { return &slots[active[i]].value; }
+
+        T* find(int key) {
+            int index = findIndex(key);
+            return index < 0 ? NULL : &slots[table[index]].value;
+        }
+
+        // Returns the existing object for key, or a freshly reset one. NULL
+        // if the pool is full.
+        T* acquire(int key) {
+
+            T* existing = find(key);
+            if (existing) return existing;
+            if (freeSlots.empty()) return NULL;
+
+            int slot = freeSlots.back();
+            freeSlots.pop_back();
+
+            slots[slot].value = T();
+            slots[slot].key = key;
+            slots[slot].used = true;
+            active.push_back(slot);
+
+            int index = home(key);
+            while (table[index] >= 0) index = (index + 1) & mask;
+            table[index] = slot;
+
+            return &slots[slot].value;
+
+        }
+
+        bool release(int key) {
+
+            int index = findIndex(key);
+            if (index < 0) return false;
+
+            int slot = table[index];
+            slots[slot].used = false;
+            slots[slot].generation++;
+            freeSlots.push_back(slot);
+
+            for (int i = 0; i < active.size(); i++) {
+                if (active[i] == slot) {
+                    active.erase(active.begin() + i);
+                    break;
+                }
+            }
+
+            // Backward-shift deletion, so lookups never need tombstones
+            int hole = index;
+            int next = index;
+            while (true) {
+                next = (next + 1) & mask;
+                if (table[next] < 0) break;
+
+                int h = home(slots[table[next]].key);
+                bool between = hole <= next ? (hole < h && h <= next) : (hole < h || h <= next);
+                if (between) continue;
+
+                table[hole] = table[next];
+                hole = next;
+            }
+            table[hole] = -1;
+
+            return true;
+
+        }
+
+        void clear() {
+            while (!active.empty()) {
+                release(slots[active.back()].key);
+            }
+        }
+
+        SlotHandle getHandle(int key) const {
+            SlotHandle handle;
+            int index = findIndex(key);
+            if (index >= 0) {
+                handle.slot = table[index];
+                handle.generation = slots[handle.slot].generation;
+            }
+            return handle;
+        }
+
+        // NULL if the slot has been released since the handle was taken
+        T* get(const SlotHandle& handle) {
+            if (handle.slot < 0 || handle.slot >= slots.size()) return NULL;
+            const Slot& slot = slots[handle.slot];
+            if (!slot.used || slot.generation != handle.generation) return NULL;
+            return &slots[handle.slot].value;
+        }
+
+    private:
+
+        struct Slot {
+
+            T               value;
+            int             key;
+            unsigned int    generation;
+            bool            used;
+
+            Slot() : value(), key(0), generation(0), used(false) {}
+
+        };
+
+        int home(int key) const {
+            unsigned int h = (unsigned int)key * 2654435761u;
+            return (h ^ (h >> 16)) & mask;
+        }
+
+        int findIndex(int key) const {
+            int index = home(key);
+            while (table[index] >= 0) {
+                if (slots[table[index]].key == key) return index;
+                index = (index + 1) & mask;
+            }
+            return -1;
+        }
+
+        std::vector<Slot>   slots;
+        std::vector<int>    active;
+        std::vector<int>    freeSlots;
+
+        std::vector<int>    table;      // slot index, or -1 if empty
+        int                 mask;
+
+    };
+
+}
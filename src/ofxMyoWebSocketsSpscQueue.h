@@ -0,0 +1,78 @@
+//
+//  ofxMyoWebSocketsSpscQueue
+//
+//  Bounded lock-free single-producer/single-consumer ring buffer. push()
+//  must only be called from one thread and pop() from one other thread.
+//  Neither side ever blocks; push() fails when the queue is full.
+//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <stddef.h>
+
+namespace ofxMyoWebSockets {
+
+    template<typename T>
+    class SpscQueue {
+
+    public:
+
+        SpscQueue(size_t capacity = 1024) : head(0), tail(0) {
+            setCapacity(capacity);
+        }
+
+        // Not thread safe, only call this while nothing is pushing or popping.
+        // Capacity is rounded up to the next power of two.
+        void setCapacity(size_t capacity) {
+            size_t size = 1;
+            while (size < capacity) size <<= 1;
+            items.assign(size, T());
+            mask = size - 1;
+            head.store(0);
+            tail.store(0);
+        }
+
+        size_t capacity() const { return items.size(); }
+
+        // Producer side
+        bool push(const T& item) {
+            size_t t = tail.load(std::memory_order_relaxed);
+            if (t - head.load(std::memory_order_acquire) >= items.size()) return false;
+            items[t & mask] = item;
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side
+        bool pop(T& item) {
+            size_t h = head.load(std::memory_order_relaxed);
+            if (h == tail.load(std::memory_order_acquire)) return false;
+            item = items[h & mask];
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Only a hint when called while the other side is active
+        size_t size() const {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size() == 0; }
+
+    private:
+
+        std::vector<T>      items;
+        size_t              mask;
+
+        // Keep the two sides on separate cache lines
+        char                padding0[64];
+        std::atomic<size_t> head;   // next slot to read, written by the consumer
+        char                padding1[64];
+        std::atomic<size_t> tail;   // next slot to write, written by the producer
+        char                padding2[64];
+
+    };
+
+}
@@ -0,0 +1,361 @@
+//
+//  ofxMyoWebSocketsStats
+//
+
+#include "ofxMyoWebSocketsStats.h"
+
+#include <sstream>
+#include <iomanip>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    // Myo Connect streams orientation at 50Hz
+    const uint64_t orientationInterval = 20000;
+
+    float age(uint64_t last, uint64_t now) {
+        if (last == 0) return -1;
+        return now > last ? (now - last) / 1000000.0f : 0;
+    }
+
+    void writeHistogram(std::ostream& out, const Histogram& histogram) {
+        out << "{\"count\":" << histogram.getCount()
+            << ",\"p50\":" << histogram.getPercentile(50)
+            << ",\"p99\":" << histogram.getPercentile(99)
+            << ",\"max\":" << histogram.getPercentile(100)
+            << ",\"buckets\":[";
+        for (int i = 0; i < Histogram::numBuckets; i++) {
+            if (i > 0) out << ",";
+            out << histogram.counts[i];
+        }
+        out << "]}";
+    }
+
+}
+
+//--------------------------------------------------------------
+Histogram::Histogram(){
+    for (int i = 0; i < numBuckets; i++) counts[i] = 0;
+}
+
+//--------------------------------------------------------------
+uint64_t Histogram::getCount() const{
+    uint64_t count = 0;
+    for (int i = 0; i < numBuckets; i++) count += counts[i];
+    return count;
+}
+
+//--------------------------------------------------------------
+uint64_t Histogram::getPercentile(float percentile) const{
+
+    uint64_t count = getCount();
+    if (count == 0) return 0;
+
+    uint64_t target = (uint64_t)(count * percentile / 100.0f);
+    if (target < 1) target = 1;
+    if (target > count) target = count;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < numBuckets; i++) {
+        seen += counts[i];
+        if (seen >= target) return getBucketLimit(i);
+    }
+
+    return getBucketLimit(numBuckets - 1);
+
+}
+
+//--------------------------------------------------------------
+int Histogram::getBucket(uint64_t micros){
+    int bucket = 0;
+    while (micros > 0 && bucket < numBuckets - 1) {
+        micros >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+//--------------------------------------------------------------
+uint64_t Histogram::getBucketLimit(int bucket){
+    return bucket == 0 ? 1 : (uint64_t)1 << bucket;
+}
+
+//--------------------------------------------------------------
+Stats::Stats(){
+    enabled = false;
+    elapsed = 0;
+    messages = 0;
+    fastPathMessages = 0;
+    messageRate = 0;
+    connects = 0;
+    disconnects = 0;
+    reconnectAttempts = 0;
+    droppedEvents = 0;
+    coalescedEvents = 0;
+}
+
+//--------------------------------------------------------------
+std::string Stats::toString() const{
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+
+    out << messageRate << " msg/s, "
+        << "handle p50/p99 " << handleTime.getPercentile(50) << "/" << handleTime.getPercentile(99) << "us, "
+        << "dispatch p50/p99 " << dispatchLatency.getPercentile(50) << "/" << dispatchLatency.getPercentile(99) << "us, "
+        << "dropped events " << droppedEvents << ", "
+        << "reconnects " << reconnectAttempts;
+
+    for (int i = 0; i < armbands.size(); i++) {
+        const ArmbandStats& armband = armbands[i];
+        out << " | myo " << armband.id << ": "
+            << armband.messageRate << " msg/s, "
+            << armband.orientationGaps << " gaps, "
+            << armband.droppedFrames << " dropped, "
+            << "rssi " << armband.rssiAge << "s old";
+    }
+
+    return out.str();
+
+}
+
+//--------------------------------------------------------------
+std::string Stats::toJson() const{
+
+    std::ostringstream out;
+
+    out << "{\"enabled\":" << (enabled ? "true" : "false")
+        << ",\"elapsed\":" << elapsed
+        << ",\"messages\":" << messages
+        << ",\"fastPathMessages\":" << fastPathMessages
+        << ",\"messageRate\":" << messageRate
+        << ",\"connects\":" << connects
+        << ",\"disconnects\":" << disconnects
+        << ",\"reconnectAttempts\":" << reconnectAttempts
+        << ",\"droppedEvents\":" << droppedEvents
+        << ",\"coalescedEvents\":" << coalescedEvents
+        << ",\"handleTime\":";
+    writeHistogram(out, handleTime);
+    out << ",\"dispatchLatency\":";
+    writeHistogram(out, dispatchLatency);
+
+    out << ",\"armbands\":[";
+    for (int i = 0; i < armbands.size(); i++) {
+        const ArmbandStats& armband = armbands[i];
+        if (i > 0) out << ",";
+        out << "{\"id\":" << armband.id
+            << ",\"messages\":" << armband.messages
+            << ",\"orientationMessages\":" << armband.orientationMessages
+            << ",\"orientationGaps\":" << armband.orientationGaps
+            << ",\"droppedFrames\":" << armband.droppedFrames
+            << ",\"messageRate\":" << armband.messageRate
+            << ",\"orientationAge\":" << armband.orientationAge
+            << ",\"rssiAge\":" << armband.rssiAge
+            << "}";
+    }
+    out << "]}";
+
+    return out.str();
+
+}
+
+//--------------------------------------------------------------
+void StatsCollector::AtomicHistogram::add(uint64_t micros){
+    counts[Histogram::getBucket(micros)].fetch_add(1, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+void StatsCollector::AtomicHistogram::copyTo(Histogram& histogram) const{
+    for (int i = 0; i < Histogram::numBuckets; i++) {
+        histogram.counts[i] = counts[i].load(std::memory_order_relaxed);
+    }
+}
+
+//--------------------------------------------------------------
+void StatsCollector::AtomicHistogram::clear(){
+    for (int i = 0; i < Histogram::numBuckets; i++) {
+        counts[i] = 0;
+    }
+}
+
+//--------------------------------------------------------------
+StatsCollector::StatsCollector(){
+
+    enabled = false;
+    numArmbands = 0;
+
+    connects = 0;
+    disconnects = 0;
+    reconnectAttempts = 0;
+
+    reset();
+
+}
+
+//--------------------------------------------------------------
+void StatsCollector::setEnabled(bool enabled){
+    this->enabled = enabled;
+}
+
+//--------------------------------------------------------------
+void StatsCollector::setMaxArmbands(int count){
+
+    armbands.reset(new ArmbandCounters[count]);
+    numArmbands = count;
+
+    for (int i = 0; i < numArmbands; i++) {
+        resetArmband(i, -1);
+        armbands[i].reportedMessages = 0;
+    }
+
+}
+
+//--------------------------------------------------------------
+void StatsCollector::reset(){
+
+    messages = 0;
+    fastPathMessages = 0;
+
+    handleTime.clear();
+    dispatchLatency.clear();
+
+    // leave the socket thread's bookkeeping alone
+    for (int i = 0; i < numArmbands; i++) {
+        ArmbandCounters& armband = armbands[i];
+        armband.messages = 0;
+        armband.orientationMessages = 0;
+        armband.orientationGaps = 0;
+        armband.droppedFrames = 0;
+        armband.reportedMessages = 0;
+    }
+
+    lastStatsTime = 0;
+    reportedMessages = 0;
+
+}
+
+//--------------------------------------------------------------
+void StatsCollector::resetArmband(int slot, int id){
+
+    if (slot < 0 || slot >= numArmbands) return;
+
+    ArmbandCounters& armband = armbands[slot];
+    armband.id = id;
+    armband.messages = 0;
+    armband.orientationMessages = 0;
+    armband.orientationGaps = 0;
+    armband.droppedFrames = 0;
+    armband.lastOrientation = 0;
+    armband.lastRssi = 0;
+    armband.lastSentTime = 0;
+
+}
+
+//--------------------------------------------------------------
+void StatsCollector::addMessage(int slot, bool fastPath){
+
+    if (!isEnabled()) return;
+
+    increment(messages);
+    if (fastPath) increment(fastPathMessages);
+
+    if (slot >= 0 && slot < numArmbands) {
+        increment(armbands[slot].messages);
+    }
+
+}
+
+//--------------------------------------------------------------
+void StatsCollector::addOrientation(int slot, uint64_t sentTime, uint64_t now){
+
+    if (!isEnabled() || slot < 0 || slot >= numArmbands) return;
+
+    ArmbandCounters& armband = armbands[slot];
+    increment(armband.orientationMessages);
+    armband.lastOrientation.store(now, std::memory_order_relaxed);
+
+    // Myo Connect's timestamps come from the armband, so unlike our receive
+    // times they aren't smeared by the network and the socket thread. Fall
+    // back on the receive time if there aren't any.
+    uint64_t time = sentTime ? sentTime : now;
+
+    if (armband.lastSentTime && time > armband.lastSentTime) {
+        uint64_t interval = time - armband.lastSentTime;
+        if (interval > orientationInterval * 2) {
+            increment(armband.orientationGaps);
+            increment(armband.droppedFrames, (interval + orientationInterval / 2) / orientationInterval - 1);
+        }
+    }
+
+    armband.lastSentTime = time;
+
+}
+
+//--------------------------------------------------------------
+void StatsCollector::addRssi(int slot, uint64_t now){
+    if (!isEnabled() || slot < 0 || slot >= numArmbands) return;
+    armbands[slot].lastRssi.store(now, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+void StatsCollector::addHandleTime(uint64_t micros){
+    if (!isEnabled()) return;
+    handleTime.add(micros);
+}
+
+//--------------------------------------------------------------
+void StatsCollector::addDispatchLatency(uint64_t micros){
+    if (!isEnabled()) return;
+    dispatchLatency.add(micros);
+}
+
+//--------------------------------------------------------------
+Stats StatsCollector::getStats(uint64_t now){
+
+    Stats stats;
+
+    stats.enabled = isEnabled();
+    stats.elapsed = lastStatsTime && now > lastStatsTime ? (now - lastStatsTime) / 1000000.0f : 0;
+
+    stats.messages = messages.load(std::memory_order_relaxed);
+    stats.fastPathMessages = fastPathMessages.load(std::memory_order_relaxed);
+    stats.messageRate = stats.elapsed > 0 ? (stats.messages - reportedMessages) / stats.elapsed : 0;
+    reportedMessages = stats.messages;
+
+    stats.connects = connects;
+    stats.disconnects = disconnects;
+    stats.reconnectAttempts = reconnectAttempts;
+
+    handleTime.copyTo(stats.handleTime);
+    dispatchLatency.copyTo(stats.dispatchLatency);
+
+    for (int i = 0; i < numArmbands; i++) {
+
+        ArmbandCounters& counters = armbands[i];
+
+        int id = counters.id.load(std::memory_order_relaxed);
+        if (id < 0) continue;
+
+        ArmbandStats armband;
+        armband.id = id;
+        armband.messages = counters.messages.load(std::memory_order_relaxed);
+        armband.orientationMessages = counters.orientationMessages.load(std::memory_order_relaxed);
+        armband.orientationGaps = counters.orientationGaps.load(std::memory_order_relaxed);
+        armband.droppedFrames = counters.droppedFrames.load(std::memory_order_relaxed);
+        armband.orientationAge = age(counters.lastOrientation.load(std::memory_order_relaxed), now);
+        armband.rssiAge = age(counters.lastRssi.load(std::memory_order_relaxed), now);
+
+        // the slot may have been handed to a new armband since last time
+        uint64_t reported = counters.reportedMessages <= armband.messages ? counters.reportedMessages : 0;
+        armband.messageRate = stats.elapsed > 0 ? (armband.messages - reported) / stats.elapsed : 0;
+        counters.reportedMessages = armband.messages;
+
+        stats.armbands.push_back(armband);
+    }
+
+    lastStatsTime = now;
+
+    return stats;
+
+}
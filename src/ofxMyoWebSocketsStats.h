@@ -0,0 +1,199 @@
+//
+//  ofxMyoWebSocketsStats
+//
+//  Counters and histograms for what's going on inside a Connection: message
+//  rates per armband, how long messages take to handle, gaps in the
+//  orientation stream and so on. See Connection::getStats().
+//
+//  Everything on the hot path is a relaxed atomic fetch_add (or store, for
+//  timestamps) behind a single enabled check, so leaving it off costs next
+//  to nothing.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace ofxMyoWebSockets {
+
+    // Counts of durations in power-of-two microsecond buckets: bucket 0 is
+    // under 1us, bucket 1 is 1us, bucket 2 is 2-3us, bucket 3 is 4-7us, ...
+    struct Histogram {
+
+        static const int numBuckets = 32;
+        uint64_t    counts[numBuckets];
+
+        Histogram();
+
+        uint64_t    getCount() const;
+
+        // Upper bound of the bucket holding the given percentile (0-100), in
+        // microseconds
+        uint64_t    getPercentile(float percentile) const;
+
+        static int      getBucket(uint64_t micros);
+        static uint64_t getBucketLimit(int bucket);
+
+    };
+
+
+    struct ArmbandStats {
+
+        int         id;
+
+        uint64_t    messages;
+        uint64_t    orientationMessages;
+
+        // Orientation messages more than twice the usual 20ms apart, and
+        // how many messages are missing in those gaps altogether
+        uint64_t    orientationGaps;
+        uint64_t    droppedFrames;
+
+        // Messages per second since the previous getStats()
+        float       messageRate;
+
+        // Seconds since the last orientation / rssi message, or -1 if there
+        // hasn't been one
+        float       orientationAge;
+        float       rssiAge;
+
+    };
+
+
+    struct Stats {
+
+        bool        enabled;
+
+        // Seconds since the previous getStats(), which the rates cover
+        float       elapsed;
+
+        uint64_t    messages;
+        uint64_t    fastPathMessages;   // decoded without building a JSON tree
+        float       messageRate;
+
+        unsigned int    connects;
+        unsigned int    disconnects;
+        unsigned int    reconnectAttempts;
+
+        // see Connection::setQueuedEvents()
+        unsigned int    droppedEvents;
+        unsigned int    coalescedEvents;
+
+        // From receiving a message to being done with it on the socket thread
+        Histogram   handleTime;
+
+        // From receiving a message to calling the event listeners, on
+        // whichever thread fires them
+        Histogram   dispatchLatency;
+
+        std::vector<ArmbandStats>   armbands;
+
+        Stats();
+
+        std::string toString() const;
+        std::string toJson() const;
+
+    };
+
+
+    // Collects the numbers behind Stats. The add*() methods are called from
+    // the socket thread (and addDispatchLatency() from wherever events are
+    // fired), getStats() from the main thread.
+    class StatsCollector {
+
+    public:
+
+        StatsCollector();
+
+        void        setEnabled(bool enabled);
+        bool        isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+        // One set of armband counters per slot, call before connecting
+        void        setMaxArmbands(int count);
+
+        void        reset();
+
+        // Socket thread. slot is the armband's slot in the ingest pool, now
+        // the receive time in microseconds.
+        void        resetArmband(int slot, int id);
+        void        addMessage(int slot, bool fastPath);
+        void        addOrientation(int slot, uint64_t sentTime, uint64_t now);
+        void        addRssi(int slot, uint64_t now);
+        void        addHandleTime(uint64_t micros);
+
+        void        addDispatchLatency(uint64_t micros);
+
+        // Counted whether or not stats are enabled, they're rare anyway
+        void        addConnect() { connects++; }
+        void        addDisconnect() { disconnects++; }
+        void        addReconnectAttempt() { reconnectAttempts++; }
+
+        // Main thread
+        Stats       getStats(uint64_t now);
+
+    private:
+
+        typedef std::atomic<uint64_t> Counter;
+
+        struct ArmbandCounters {
+
+            std::atomic<int>    id;     // -1 if the slot is free
+
+            Counter     messages;
+            Counter     orientationMessages;
+            Counter     orientationGaps;
+            Counter     droppedFrames;
+            Counter     lastOrientation;
+            Counter     lastRssi;
+
+            // socket thread only
+            uint64_t    lastSentTime;
+
+            // main thread only
+            uint64_t    reportedMessages;
+
+        };
+
+        struct AtomicHistogram {
+
+            Counter     counts[Histogram::numBuckets];
+
+            void        add(uint64_t micros);
+            void        copyTo(Histogram& histogram) const;
+            void        clear();
+
+        };
+
+        // reset() clears the counters from the main thread while the socket
+        // thread adds to them, so a load & store could bring back what was
+        // just cleared
+        static void increment(Counter& counter, uint64_t amount = 1) {
+            counter.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        std::atomic<bool>   enabled;
+
+        Counter             messages;
+        Counter             fastPathMessages;
+
+        std::atomic<unsigned int>   connects;
+        std::atomic<unsigned int>   disconnects;
+        std::atomic<unsigned int>   reconnectAttempts;
+
+        AtomicHistogram     handleTime;
+        AtomicHistogram     dispatchLatency;
+
+        std::unique_ptr<ArmbandCounters[]>  armbands;
+        int                                 numArmbands;
+
+        // main thread, for rates
+        uint64_t            lastStatsTime;
+        uint64_t            reportedMessages;
+
+    };
+
+}
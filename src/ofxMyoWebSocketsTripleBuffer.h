@@ -0,0 +1,53 @@
+//
+//  ofxMyoWebSocketsTripleBuffer
+//
+//  Lock-free single-producer/single-consumer triple buffer. The producer
+//  always has a back buffer to write into and never waits on the consumer,
+//  and the consumer always sees the most recently published buffer as a
+//  whole, never a half-written one.
+//
+
+#pragma once
+
+#include <atomic>
+
+namespace ofxMyoWebSockets {
+
+    template<typename T>
+    class TripleBuffer {
+
+    public:
+
+        TripleBuffer() : middle(1), frontIndex(0), backIndex(2) {}
+
+        // Producer side: fill back(), then publish() it
+        T&      back() { return buffers[backIndex]; }
+
+        void publish() {
+            int previous = middle.exchange(backIndex | DIRTY, std::memory_order_acq_rel);
+            backIndex = previous & INDEX;
+        }
+
+        // Consumer side: returns true if a newer buffer was swapped into front()
+        bool consume() {
+            if (!(middle.load(std::memory_order_relaxed) & DIRTY)) return false;
+            int previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+            frontIndex = previous & INDEX;
+            return true;
+        }
+
+        const T& front() const { return buffers[frontIndex]; }
+
+    private:
+
+        enum { INDEX = 3, DIRTY = 4 };
+
+        T                   buffers[3];
+        std::atomic<int>    middle;     // index of the middle buffer + dirty flag
+
+        int                 frontIndex; // only touched by the consumer
+        int                 backIndex;  // only touched by the producer
+
+    };
+
+}
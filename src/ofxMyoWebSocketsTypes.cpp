@@ -0,0 +1,117 @@
+//
+//  ofxMyoWebSocketsTypes
+//
+
+#include "ofxMyoWebSocketsTypes.h"
+
+#include <string.h>
+
+using namespace ofxMyoWebSockets;
+
+namespace {
+
+    const char* poseNames[] = {
+        "unknown",
+        "rest",
+        "fist",
+        "wave_in",
+        "wave_out",
+        "fingers_spread",
+        "double_tap",
+        "thumb_to_pinky"
+    };
+
+    const char* armNames[] = {
+        "unknown",
+        "left",
+        "right"
+    };
+
+    const char* directionNames[] = {
+        "unknown",
+        "toward_wrist",
+        "toward_elbow"
+    };
+
+    const char* eventNames[] = {
+        "unknown",
+        "paired",
+        "unpaired",
+        "connected",
+        "disconnected",
+        "arm_recognized",
+        "arm_lost",
+        "arm_synced",
+        "arm_unsynced",
+        "orientation",
+        "pose",
+        "locked",
+        "unlocked",
+        "rssi",
+        "emg"
+    };
+
+    // Index of name in names, or 0 (always "unknown") if it isn't there.
+    // Checking the length and first character first means most entries are
+    // rejected without touching the rest of the string.
+    int lookup(const char* name, size_t length, const char** names, int count) {
+        for (int i = 1; i < count; i++) {
+            if (names[i][0] == name[0] && strlen(names[i]) == length && memcmp(names[i], name, length) == 0) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    template<typename T, size_t N>
+    int count(T (&)[N]) { return N; }
+
+}
+
+//--------------------------------------------------------------
+Pose ofxMyoWebSockets::parsePose(const char* name, size_t length){
+    if (length == 0) return POSE_UNKNOWN;
+    return (Pose)lookup(name, length, poseNames, count(poseNames));
+}
+
+//--------------------------------------------------------------
+Arm ofxMyoWebSockets::parseArm(const char* name, size_t length){
+    if (length == 0) return ARM_UNKNOWN;
+    return (Arm)lookup(name, length, armNames, count(armNames));
+}
+
+//--------------------------------------------------------------
+XDirection ofxMyoWebSockets::parseXDirection(const char* name, size_t length){
+    if (length == 0) return X_DIRECTION_UNKNOWN;
+    return (XDirection)lookup(name, length, directionNames, count(directionNames));
+}
+
+//--------------------------------------------------------------
+EventType ofxMyoWebSockets::parseEventType(const char* name, size_t length){
+    if (length == 0) return EVENT_UNKNOWN;
+    return (EventType)lookup(name, length, eventNames, count(eventNames));
+}
+
+//--------------------------------------------------------------
+const char* ofxMyoWebSockets::toString(Pose pose){
+    if (pose < 0 || pose >= count(poseNames)) return poseNames[0];
+    return poseNames[pose];
+}
+
+//--------------------------------------------------------------
+const char* ofxMyoWebSockets::toString(Arm arm){
+    if (arm < 0 || arm >= count(armNames)) return armNames[0];
+    return armNames[arm];
+}
+
+//--------------------------------------------------------------
+const char* ofxMyoWebSockets::toString(XDirection direction){
+    if (direction < 0 || direction >= count(directionNames)) return directionNames[0];
+    return directionNames[direction];
+}
+
+//--------------------------------------------------------------
+const char* ofxMyoWebSockets::toString(EventType type){
+    if (type < 0 || type >= count(eventNames)) return eventNames[0];
+    return eventNames[type];
+}
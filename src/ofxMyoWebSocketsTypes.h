@@ -0,0 +1,97 @@
+//
+//  ofxMyoWebSocketsTypes
+//
+//  Poses, arms, directions and event types as sent by Myo Connect. These are
+//  parsed from their strings once when a message comes in, and can be
+//  compared against the original strings for compatibility, e.g.
+//  armband.pose == "fist"
+//
+
+#pragma once
+
+#include <string>
+#include <ostream>
+#include <stddef.h>
+
+namespace ofxMyoWebSockets {
+
+    enum Pose {
+        POSE_UNKNOWN,
+        POSE_REST,
+        POSE_FIST,
+        POSE_WAVE_IN,
+        POSE_WAVE_OUT,
+        POSE_FINGERS_SPREAD,
+        POSE_DOUBLE_TAP,
+        POSE_THUMB_TO_PINKY
+    };
+
+    enum Arm {
+        ARM_UNKNOWN,
+        ARM_LEFT,
+        ARM_RIGHT
+    };
+
+    enum XDirection {
+        X_DIRECTION_UNKNOWN,
+        X_DIRECTION_TOWARD_WRIST,
+        X_DIRECTION_TOWARD_ELBOW
+    };
+
+    enum EventType {
+        EVENT_UNKNOWN,
+        EVENT_PAIRED,
+        EVENT_UNPAIRED,
+        EVENT_CONNECTED,
+        EVENT_DISCONNECTED,
+        EVENT_ARM_RECOGNIZED,
+        EVENT_ARM_LOST,
+        EVENT_ARM_SYNCED,
+        EVENT_ARM_UNSYNCED,
+        EVENT_ORIENTATION,
+        EVENT_POSE,
+        EVENT_LOCKED,
+        EVENT_UNLOCKED,
+        EVENT_RSSI,
+        EVENT_EMG
+    };
+
+    // string -> enum, anything unrecognized maps to the UNKNOWN value
+    Pose        parsePose(const char* name, size_t length);
+    Arm         parseArm(const char* name, size_t length);
+    XDirection  parseXDirection(const char* name, size_t length);
+    EventType   parseEventType(const char* name, size_t length);
+
+    inline Pose         parsePose(const std::string& name) { return parsePose(name.data(), name.size()); }
+    inline Arm          parseArm(const std::string& name) { return parseArm(name.data(), name.size()); }
+    inline XDirection   parseXDirection(const std::string& name) { return parseXDirection(name.data(), name.size()); }
+    inline EventType    parseEventType(const std::string& name) { return parseEventType(name.data(), name.size()); }
+
+    // enum -> string, as used by Myo Connect
+    const char* toString(Pose pose);
+    const char* toString(Arm arm);
+    const char* toString(XDirection direction);
+    const char* toString(EventType type);
+
+    // Compatibility with code written against the old string fields
+    inline bool operator==(Pose a, const std::string& b) { return b == toString(a); }
+    inline bool operator==(const std::string& a, Pose b) { return a == toString(b); }
+    inline bool operator!=(Pose a, const std::string& b) { return b != toString(a); }
+    inline bool operator!=(const std::string& a, Pose b) { return a != toString(b); }
+
+    inline bool operator==(Arm a, const std::string& b) { return b == toString(a); }
+    inline bool operator==(const std::string& a, Arm b) { return a == toString(b); }
+    inline bool operator!=(Arm a, const std::string& b) { return b != toString(a); }
+    inline bool operator!=(const std::string& a, Arm b) { return a != toString(b); }
+
+    inline bool operator==(XDirection a, const std::string& b) { return b == toString(a); }
+    inline bool operator==(const std::string& a, XDirection b) { return a == toString(b); }
+    inline bool operator!=(XDirection a, const std::string& b) { return b != toString(a); }
+    inline bool operator!=(const std::string& a, XDirection b) { return a != toString(b); }
+
+    inline std::ostream& operator<<(std::ostream& os, Pose pose) { return os << toString(pose); }
+    inline std::ostream& operator<<(std::ostream& os, Arm arm) { return os << toString(arm); }
+    inline std::ostream& operator<<(std::ostream& os, XDirection direction) { return os << toString(direction); }
+    inline std::ostream& operator<<(std::ostream& os, EventType type) { return os << toString(type); }
+
+}